@@ -6,6 +6,12 @@ namespace poker {
 
 class AggressiveAI : public Strategy<AggressiveAI> {
 public:
+    // 난수 고정 (매치업 재현용). 안 부르면 스레드마다 random_device 로 시드한 난수를 같이 쓴다
+    void seed(std::uint32_t value) {
+        rng_.seed(value);
+        seeded_ = true;
+    }
+
     Decision decide_impl(const Hand<5>& hand, size_t pot, size_t to_call) {
         auto rank = hand.evaluate();
         
@@ -27,10 +33,12 @@ public:
     }
 
 private:
+    std::mt19937 rng_;
+    bool seeded_{false};
+
     bool bluff() {
-        static std::mt19937 rng{std::random_device{}()};
-        static std::uniform_int_distribution<int> dist(0, 1);
-        return dist(rng) == 1;
+        thread_local std::mt19937 shared{std::random_device{}()};
+        return std::uniform_int_distribution<int>(0, 1)(seeded_ ? rng_ : shared) == 1;
     }
 };
 
@@ -0,0 +1,415 @@
+#pragma once
+#include "../strategy.hpp"
+#include "../game.hpp"
+#include "../parallel.hpp"
+#include "conservative.hpp"
+#include "aggressive.hpp"
+#include "smart.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace poker {
+
+struct MctsOptions {
+    std::chrono::microseconds budget{20'000};   // decide 한 번의 벽시계 한도
+    unsigned threads{1};                        // 루트 병렬 트리 수 (0 = 하드웨어 스레드 수, 그 이상은 잘린다)
+    size_t max_nodes{1 << 14};                  // 트리 하나의 노드 풀 크기
+    std::uint64_t max_iterations{0};            // 트리 하나의 반복 한도 (0 = 시간 한도까지)
+    double exploration{1.0};                    // UCB 탐색 상수 (보상 표준편차 단위)
+    std::uint64_t seed{0};                      // 0 = random_device
+};
+
+namespace detail {
+
+    // 트리의 액션 추상화. 금액은 그 시점의 팟/콜 금액으로 정한다
+    enum class MctsMove : std::uint8_t { Fold, Call, HalfPot, Pot, AllIn };
+    inline constexpr size_t MCTS_MOVES = 5;
+
+    inline bool legal(MctsMove move, const GameState& state) {
+        const auto& seat = state.seats[state.to_act];
+        std::uint32_t owed = state.to_call();
+        switch (move) {
+            case MctsMove::Fold:    return owed > 0;   // 공짜로 볼 수 있으면 접지 않는다
+            case MctsMove::Call:    return true;
+            case MctsMove::HalfPot:
+            case MctsMove::Pot:     return seat.chips > owed;
+            case MctsMove::AllIn:   return seat.chips > 0;
+        }
+        return false;
+    }
+
+    inline Decision concretize(MctsMove move, const GameState& state) {
+        std::uint32_t owed = state.to_call();
+        std::uint32_t min_raise = state.small_blind * 2;
+        switch (move) {
+            case MctsMove::Fold:    return Decision{Action::Fold, 0};
+            case MctsMove::Call:
+                if (owed == 0) return Decision{Action::Check, 0};
+                return Decision{Action::Call, owed};
+            case MctsMove::HalfPot: return Decision{Action::Raise, std::max(state.pot / 2, min_raise)};
+            case MctsMove::Pot:     return Decision{Action::Raise, std::max(state.pot, min_raise)};
+            case MctsMove::AllIn:   return Decision{Action::AllIn, state.seats[state.to_act].chips};
+        }
+        return Decision{Action::Fold, 0};
+    }
+
+    // 자식은 MCTS_MOVES 개가 연속으로 붙는다 (first_child + move)
+    struct MctsNode {
+        std::uint32_t first_child{0};   // 0 = 아직 펼치지 않음 (0번은 루트라 자식일 수 없다)
+        std::uint32_t visits{0};
+        double reward{0.0};             // 보상 합
+        double reward_sq{0.0};          // 보상 제곱 합 (분산)
+    };
+
+    // 트리 하나의 노드 풀. decide 마다 비우고 다시 쓴다 (할당은 처음 한 번)
+    class MctsArena {
+    public:
+        void reset(size_t capacity) {
+            if (nodes_.size() != capacity) nodes_.assign(capacity, MctsNode{});
+            used_ = 0;
+        }
+
+        // 연속 count 개. 풀이 모자라면 0 (더 펼치지 않고 롤아웃만 한다)
+        std::uint32_t allocate(size_t count) {
+            if (used_ + count > nodes_.size()) return 0;
+            auto first = static_cast<std::uint32_t>(used_);
+            std::fill_n(nodes_.begin() + static_cast<std::ptrdiff_t>(used_), count, MctsNode{});
+            used_ += count;
+            return first;
+        }
+
+        MctsNode& operator[](std::uint32_t i) { return nodes_[i]; }
+        const MctsNode& operator[](std::uint32_t i) const { return nodes_[i]; }
+        size_t used() const { return used_; }
+
+    private:
+        std::vector<MctsNode> nodes_;
+        size_t used_{0};
+    };
+
+} // namespace detail
+
+// 직전 decide 의 탐색 결과 (루트 액션별, 모든 트리 합산)
+struct MctsReport {
+    std::uint64_t iterations{0};
+    std::array<std::uint64_t, detail::MCTS_MOVES> visits{};
+    std::array<double, detail::MCTS_MOVES> mean{};   // 평균 보상 (대략 -1 ~ 1)
+    std::chrono::microseconds elapsed{0};
+    bool searched{false};   // false = 탐색 없이 플레이아웃 정책으로 결정
+};
+
+/*
+결정화(determinized) 몬테카를로 트리 탐색 AI
+
+    MctsAI mcts{{.budget = std::chrono::milliseconds(5), .threads = 4}};
+    game.add_player(&player, mcts);   // add_player 가 attach(game) 를 불러준다
+
+decide 마다 Game::snapshot() 에서 시작해서
+1. 상대 카드를 안 보이는 카드(덱 - 내 핸드)에서 새로 뽑는다 (결정화)
+   상대 좌석마다 Conservative/Aggressive/Smart 중 하나를 같이 뽑고, Game::actions() 의
+   실제 액션과 맞는 조합만 받아들인다. 레이즈한 상대를 무작위 핸드로 보면 블러핑을 과대평가한다
+2. 내 차례는 트리에서 UCB 로 고르고, 상대 차례와 트리 밖은 뽑은 휴리스틱 AI 로 굴린다
+3. 쇼다운까지 간 칩 증감을 (스택 + 팟) 으로 나눈 값을 보상으로 거꾸로 전파
+
+트리 노드는 내 액션 순서로만 구분한다 (open-loop). 상대 카드와 액션은 매번 달라지므로
+같은 노드가 여러 정보 집합을 평균 낸다.
+트리는 스레드마다 따로 키우고(루트 병렬, AI 가 들고 있는 WorkerPool 에서) 끝나면 루트 통계를 합쳐 평균 보상이 가장 큰 액션을 고른다.
+시간 한도는 기각 시도마다, 롤아웃의 정책 결정마다 확인하고 넘으면 그 반복을 버린다.
+그래서 넘어도 정책 결정 한 번 (처음 보는 핸드의 에퀴티 계산 포함 수십 마이크로초) 이내다.
+결정화 한 번은 시도 MAX_REJECTIONS 번 또는 budget / SAMPLING_SLICE 중 먼저 닿는 쪽에서 멈춘다.
+
+attach 한 Game 이 살아 있는 동안만 쓴다. Game 밖에서 불리거나 한 번도 못 돌았으면
+SmartAI 로 결정한다.
+*/
+class MctsAI : public Strategy<MctsAI> {
+public:
+    explicit MctsAI(MctsOptions options = {})
+        : options_(options),
+          seed_(options.seed ? options.seed : std::random_device{}())
+    {}
+
+    void attach(const Game& game) { game_ = &game; }
+
+    Decision decide_impl(const Hand<5>& hand, size_t pot, size_t to_call) {
+        using clock = std::chrono::steady_clock;
+        const auto start = clock::now();
+        const auto deadline = start + options_.budget;
+        report_ = MctsReport{};
+
+        if (!game_) return fallback_.decide(hand, pot, to_call);
+        const GameState root = game_->snapshot();
+        const size_t hero = root.to_act;
+        if (root.finished || root.hand_cards(hero) != CardSet{hand}) {
+            return fallback_.decide(hand, pot, to_call);
+        }
+
+        // 안 보이는 카드 = 내 핸드를 뺀 전부 (상대 핸드와 남은 덱 순서는 모른다)
+        Unseen unseen{};
+        for (std::uint64_t b = (~CardSet{hand}).bits(); b; b &= b - 1) {
+            unseen.cards[unseen.count++] = static_cast<std::uint8_t>(std::countr_zero(b));
+        }
+
+        // 코어보다 많으면 시분할 때문에 늦게 도는 트리가 마감을 넘긴다
+        unsigned threads = std::min(options_.threads ? options_.threads : default_thread_count(),
+                                    default_thread_count());
+        if (arenas_.size() != threads) arenas_.resize(threads);
+        const std::uint64_t decision = decisions_++;
+
+        // 풀은 처음 한 번만 띄운다 (decide 마다 스레드를 만들면 짧은 budget 의 상당 부분을 먹는다)
+        if (threads > 1 && (!pool_ || pool_->size() != threads)) pool_ = std::make_unique<WorkerPool>(threads);
+
+        std::vector<std::uint64_t> iterations(threads);
+        auto grow = [&](size_t tree, unsigned) {
+            std::mt19937_64 rng{seed_ + (decision * threads + tree) * 0x9E3779B97F4A7C15ull};
+            iterations[tree] = search(arenas_[tree], root, hero, unseen, game_->actions(), deadline, rng);
+        };
+        if (threads > 1) {
+            pool_->run(threads, grow);
+        } else {
+            grow(0, 0u);
+        }
+
+        // 루트 자식 통계를 합쳐서 평균 보상이 가장 큰 액션
+        // (탐색 항이 분산에 비례해서 방문 수는 올인처럼 흔들리는 액션에 몰린다)
+        std::array<double, detail::MCTS_MOVES> reward{};
+        for (size_t t = 0; t < threads; ++t) {
+            report_.iterations += iterations[t];
+            const auto& arena = arenas_[t];
+            if (arena.used() == 0 || arena[0].first_child == 0) continue;
+            for (size_t m = 0; m < detail::MCTS_MOVES; ++m) {
+                const auto& child = arena[arena[0].first_child + static_cast<std::uint32_t>(m)];
+                report_.visits[m] += child.visits;
+                reward[m] += child.reward;
+            }
+        }
+        report_.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start);
+
+        size_t best = detail::MCTS_MOVES;
+        for (size_t m = 0; m < detail::MCTS_MOVES; ++m) {
+            if (report_.visits[m] == 0) continue;
+            report_.mean[m] = reward[m] / static_cast<double>(report_.visits[m]);
+            if (best == detail::MCTS_MOVES || report_.mean[m] > report_.mean[best]) {
+                best = m;
+            }
+        }
+        if (best == detail::MCTS_MOVES) return fallback_.decide(hand, pot, to_call);
+
+        report_.searched = true;
+        return detail::concretize(static_cast<detail::MctsMove>(best), root);
+    }
+
+    const MctsReport& last_report() const { return report_; }
+
+private:
+    // 트리 깊이 한도 (내 결정 횟수). 넘으면 트리 밖으로 보고 롤아웃한다
+    static constexpr size_t MAX_DEPTH = 32;
+    // 상대 핸드 하나를 기각 샘플링으로 뽑는 최대 시도 (넘으면 마지막 것을 쓴다)
+    static constexpr size_t MAX_REJECTIONS = 64;
+    // 반복 하나의 결정화에 쓰는 시간 상한 = budget / SAMPLING_SLICE (넘으면 시도 횟수와 같이 마지막 것을 쓴다)
+    static constexpr int SAMPLING_SLICE = 32;
+
+    struct Unseen {
+        std::array<std::uint8_t, 52> cards;
+        size_t count{0};
+    };
+
+    // 상대 좌석별 플레이아웃 정책
+    enum class Policy : std::uint8_t { Conservative, Aggressive, Smart };
+
+    struct Playouts {
+        ConservativeAI conservative;
+        AggressiveAI aggressive;
+        SmartAI smart;
+
+        Decision decide(Policy policy, const Hand<5>& hand, size_t pot, size_t to_call) {
+            switch (policy) {
+                case Policy::Conservative: return conservative.decide(hand, pot, to_call);
+                case Policy::Aggressive:   return aggressive.decide(hand, pot, to_call);
+                case Policy::Smart:        break;
+            }
+            return smart.decide(hand, pot, to_call);
+        }
+
+        Decision decide(Policy policy, const GameState& state) {
+            return decide(policy, state.hand(state.to_act), state.pot, state.to_call());
+        }
+    };
+
+    MctsOptions options_;
+    std::uint64_t seed_;
+    const Game* game_{nullptr};
+    std::vector<detail::MctsArena> arenas_;
+    std::unique_ptr<WorkerPool> pool_;      // 루트 병렬 트리용 (threads > 1 일 때만)
+    std::uint64_t decisions_{0};
+    SmartAI fallback_;
+    MctsReport report_;
+
+    // 트리 하나를 deadline 까지 키운다. 반복 횟수를 돌려준다
+    // 마감은 기각 시도마다, 롤아웃 결정마다 확인하고 넘으면 그 반복은 버린다 (역전파하지 않는다)
+    std::uint64_t search(detail::MctsArena& arena, const GameState& root, size_t hero, Unseen unseen,
+                         const std::vector<Game::ActionRecord>& history,
+                         std::chrono::steady_clock::time_point deadline, std::mt19937_64& rng) const {
+        using clock = std::chrono::steady_clock;
+        arena.reset(options_.max_nodes);
+        arena.allocate(1);  // 루트
+
+        const double scale = std::max<double>(1.0, root.seats[hero].chips + root.pot);
+        const auto sampling_slice = options_.budget / SAMPLING_SLICE;
+        Playouts playouts;
+        std::array<std::uint32_t, MAX_DEPTH + 1> path{};
+        std::uint64_t done = 0;
+
+        // 좌석별 지난 액션 (기각 시도마다 전체 기록을 훑지 않게 한 번만 나눠 둔다)
+        std::array<std::vector<Replay>, GameState::MAX_SEATS> replays;
+        for (const auto& record : history) {
+            if (record.seat < replays.size()) {
+                replays[record.seat].push_back(Replay{record.pot, record.to_call, action_kind(record.action)});
+            }
+        }
+
+        // 곱셈-시프트로 [0, n) (나눗셈 없음)
+        auto below = [&](size_t n) {
+            return static_cast<size_t>((std::uint64_t{static_cast<std::uint32_t>(rng())} * n) >> 32);
+        };
+
+        while ((options_.max_iterations == 0 || done < options_.max_iterations) && clock::now() < deadline) {
+            // 1. 결정화: 살아 있는 상대마다 안 보이는 카드 5장(부분 셔플)과 정책을 뽑는다.
+            //    그 정책이 이번 핸드의 실제 액션을 똑같이 고를 때만 받아들이면
+            //    핸드와 정책이 액션 확률에 비례해서 뽑힌다 (기각 샘플링)
+            //    시도는 MAX_REJECTIONS 번 또는 sampling_slice 까지. 마감을 넘기면 반복을 버린다
+            GameState state = root;
+            std::array<Policy, GameState::MAX_SEATS> policy{};
+            size_t next = 0;
+            const auto sampling_end = std::min(deadline, clock::now() + sampling_slice);
+            bool expired = false;
+            for (size_t s = 0; s < state.seat_count && !expired; ++s) {
+                if (s == hero || !state.seats[s].live) continue;
+                for (size_t attempt = 1; ; ++attempt) {
+                    CardSet cards;
+                    for (size_t c = next; c < next + 5; ++c) {
+                        std::swap(unseen.cards[c], unseen.cards[c + below(unseen.count - c)]);
+                        cards.insert_index(unseen.cards[c]);
+                    }
+                    policy[s] = static_cast<Policy>(below(3));
+                    if (consistent(playouts, policy[s], cards, replays[s])) break;
+                    if (attempt == MAX_REJECTIONS) break;
+                    const auto now = clock::now();
+                    expired = now >= deadline;
+                    if (now >= sampling_end) break;
+                }
+                for (auto& card : state.seats[s].hand) card.index = unseen.cards[next++];
+            }
+            if (expired) break;
+
+            // 2. 선택/확장은 내 차례에서만, 나머지는 정책으로 (정책 결정마다 마감 확인)
+            size_t depth = 0;
+            bool in_tree = true;
+            while (!state.finished && !expired) {
+                if (state.to_act != hero || !in_tree || depth == MAX_DEPTH) {
+                    if ((expired = clock::now() >= deadline)) break;
+                }
+                if (state.to_act != hero) {
+                    state.apply(playouts.decide(policy[state.to_act], state));
+                    continue;
+                }
+                if (!in_tree || depth == MAX_DEPTH) {
+                    in_tree = false;
+                    state.apply(playouts.decide(Policy::Smart, state));
+                    continue;
+                }
+
+                auto& node = arena[path[depth]];
+                if (node.first_child == 0) node.first_child = arena.allocate(detail::MCTS_MOVES);
+                if (node.first_child == 0) {   // 풀이 찼다
+                    in_tree = false;
+                    continue;
+                }
+
+                size_t move = select(arena, node, state, rng);
+                auto child = node.first_child + static_cast<std::uint32_t>(move);
+                path[++depth] = child;
+                in_tree = arena[child].visits > 0;   // 새 노드까지만 트리에서 내려간다
+                state.apply(detail::concretize(static_cast<detail::MctsMove>(move), state));
+            }
+
+            if (expired) break;
+
+            // 3. 역전파
+            double reward = (static_cast<double>(state.seats[hero].chips) -
+                             static_cast<double>(root.seats[hero].chips)) / scale;
+            for (size_t d = 0; d <= depth; ++d) {
+                auto& node = arena[path[d]];
+                ++node.visits;
+                node.reward += reward;
+                node.reward_sq += reward * reward;
+            }
+            ++done;
+        }
+        return done;
+    }
+
+    // 지난 액션 하나: 그때 팟/콜 금액과 액션 종류 (폴드 0 / 체크·콜 1 / 베팅 2)
+    struct Replay {
+        std::uint32_t pot;
+        std::uint32_t to_call;
+        int kind;
+    };
+
+    static int action_kind(Action action) {
+        switch (action) {
+            case Action::Fold:  return 0;
+            case Action::Check:
+            case Action::Call:  return 1;
+            default:            return 2;
+        }
+    }
+
+    // policy 가 cards 를 들고 그 좌석의 지난 액션을 같은 종류로 고르는가
+    static bool consistent(Playouts& playouts, Policy policy, CardSet cards, const std::vector<Replay>& replays) {
+        if (replays.empty()) return true;
+        auto hand = make_hand<5>(cards);
+        for (const auto& r : replays) {
+            if (action_kind(playouts.decide(policy, hand, r.pot, r.to_call).action) != r.kind) return false;
+        }
+        return true;
+    }
+
+    // UCB (탐색 항을 보상 표준편차로 스케일). 안 가본 합법 액션이 있으면 그중 하나를 무작위로
+    size_t select(const detail::MctsArena& arena, const detail::MctsNode& node,
+                  const GameState& state, std::mt19937_64& rng) const {
+        std::array<size_t, detail::MCTS_MOVES> fresh{};
+        size_t fresh_count = 0;
+        size_t best = 1;    // Call 은 항상 합법
+        double best_score = -std::numeric_limits<double>::infinity();
+        const double log_parent = std::log(static_cast<double>(std::max<std::uint32_t>(node.visits, 1)));
+
+        for (size_t m = 0; m < detail::MCTS_MOVES; ++m) {
+            if (!detail::legal(static_cast<detail::MctsMove>(m), state)) continue;
+            const auto& child = arena[node.first_child + static_cast<std::uint32_t>(m)];
+            if (child.visits == 0) {
+                fresh[fresh_count++] = m;
+                continue;
+            }
+            double n = static_cast<double>(child.visits);
+            double mean = child.reward / n;
+            double variance = std::max(child.reward_sq / n - mean * mean, 1e-6);
+            double score = mean + options_.exploration * std::sqrt(variance * log_parent / n);
+            if (score > best_score) {
+                best_score = score;
+                best = m;
+            }
+        }
+        if (fresh_count > 0) return fresh[rng() % fresh_count];
+        return best;
+    }
+};
+
+} // namespace poker
@@ -1,13 +1,39 @@
 #pragma once
 #include "../strategy.hpp"
+#include "../stats.hpp"
+#include "../equity_cache.hpp"
+#include "../hand_equity.hpp"
+#include <algorithm>
+#include <functional>
 #include <random>
+#include <vector>
 
 namespace poker {
 
 class SmartAI : public Strategy<SmartAI> {
 public:
+    // 상대 통계 연결 (StatsTracker::player() 로 받은 참조)
+    void watch(const PlayerStats& opponent) {
+        opponents_.push_back(&opponent);
+    }
+
+    // 난수 고정 (매치업 재현용). 안 부르면 스레드마다 random_device 로 시드한 난수를 같이 쓴다
+    void seed(std::uint32_t value) {
+        rng_.seed(value);
+        seeded_ = true;
+    }
+
+    // add_player 가 불러준다. 이 테이블에서 아직 폴드하지 않은 상대 수로 에퀴티를 본다
+    // (attach 한 Game 이 살아 있는 동안만. Game 은 복사/이동할 수 없다. 여러 테이블에 앉히면 마지막 테이블)
+    template<typename Table>
+    void attach(const Table& table) {
+        live_opponents_ = [&table] { return table.active_players() - 1; };
+    }
+
     Decision decide_impl(const Hand<5>& hand, size_t pot, size_t to_call) {
-        double hand_strength = calculate_strength(hand);
+        auto read = read_opponents();
+        // 보정 뒤에도 확률로 쓰므로 [0, 1] 로 자른다
+        double hand_strength = std::clamp(calculate_strength(hand) + read.strength_bonus, 0.0, 1.0);
         
         // 기대값 계산
         // EV = (이길 확률 × 이길 때 이득) - (질 확률 × 잃을 금액)
@@ -27,7 +53,7 @@ public:
         } else if (to_call == 0) {
             // 콜할 필요 없으면 체크
             return Decision{Action::Check, 0};
-        } else if (hand_strength > 0.5 && should_bluff()) {
+        } else if (hand_strength > 0.5 && should_bluff(read.bluff_percent)) {
             // 가끔 블러핑
             return Decision{Action::Raise, to_call * 2};
         }
@@ -36,20 +62,52 @@ public:
     }
 
 private:
-    // 족보별 대략적인 승률
-    double calculate_strength(const Hand<5>& hand) const {
-        switch (hand.evaluate()) {
-            case HandRank::RoyalFlush:    return 1.00;
-            case HandRank::StraightFlush: return 0.99;
-            case HandRank::FourOfKind:    return 0.98;
-            case HandRank::FullHouse:     return 0.95;
-            case HandRank::Flush:         return 0.90;
-            case HandRank::Straight:      return 0.85;
-            case HandRank::ThreeOfKind:   return 0.75;
-            case HandRank::TwoPair:       return 0.60;
-            case HandRank::OnePair:       return 0.40;
-            default:                      return 0.20;
+    // 통계를 믿기 시작하는 최소 핸드 수
+    static constexpr std::uint64_t MIN_HANDS = 30;
+
+    struct OpponentRead {
+        double strength_bonus{0.0};  // 상대 성향에 따른 핸드 강도 보정
+        int bluff_percent{15};
+    };
+
+    std::vector<const PlayerStats*> opponents_;
+    std::function<size_t()> live_opponents_;    // attach 한 테이블 (없으면 헤즈업으로 본다)
+    std::mt19937 rng_;
+    bool seeded_{false};
+
+    // 상대들의 스냅샷을 평균 내서 보정값을 만든다 (락 없음, 카운터 몇 개 읽기)
+    OpponentRead read_opponents() const {
+        OpponentRead read;
+        double vpip = 0.0, aggression = 0.0, fold_to_raise = 0.0;
+        int known = 0;
+        for (auto* stats : opponents_) {
+            auto p = stats->snapshot();
+            if (p.hands < MIN_HANDS) continue;
+            vpip += p.vpip_rate();
+            aggression += p.aggression_frequency();
+            fold_to_raise += p.fold_to_raise();
+            ++known;
         }
+        if (known == 0) return read;
+        vpip /= known;
+        aggression /= known;
+        fold_to_raise /= known;
+
+        // 루즈/공격적인 상대는 약한 패로도 베팅하므로 우리 패를 더 높게 본다
+        read.strength_bonus = 0.1 * (aggression - 0.5) + 0.1 * (vpip - 0.4);
+        // 레이즈에 잘 접는 상대에게는 블러핑을 늘린다 (15% ~ 45%)
+        read.bluff_percent = 15 + static_cast<int>(std::max(0.0, fold_to_raise - 0.5) * 60);
+        return read;
+    }
+
+    // 남은 47장에서 나올 수 있는 상대 핸드 전체에 대한 정확한 에퀴티 (아직 남은 상대 수만큼 근사)
+    // 테이블에 붙지 않았으면 (MctsAI 의 플레이아웃 등) 헤즈업으로 본다
+    // 모든 테이블/스레드의 SmartAI 가 같은 캐시를 쓰므로 자주 나오는 핸드는 조회 한 번
+    double calculate_strength(const Hand<5>& hand) const {
+        const size_t opponents = live_opponents_ ? std::max<size_t>(live_opponents_(), 1) : 1;
+        return EquityCache::shared().get(EquityCache::key(CardSet{hand}, opponents), [&] {
+            return HandEquity::shared().equity(hand, opponents);
+        });
     }
     
     double calculate_pot_odds(size_t pot, size_t to_call) const {
@@ -57,18 +115,19 @@ private:
         return static_cast<double>(pot) / (pot + to_call);
     }
     
+    std::mt19937& rng() {
+        thread_local std::mt19937 shared{std::random_device{}()};
+        return seeded_ ? rng_ : shared;
+    }
+    
     // -0.1 ~ 0.1 랜덤 값
     double random_factor() {
-        static std::mt19937 rng{std::random_device{}()};
-        static std::uniform_real_distribution<double> dist(-0.1, 0.1);
-        return dist(rng);
+        return std::uniform_real_distribution<double>(-0.1, 0.1)(rng());
     }
     
-    // 15% 확률로 블러핑
-    bool should_bluff() {
-        static std::mt19937 rng{std::random_device{}()};
-        static std::uniform_int_distribution<int> dist(1, 100);
-        return dist(rng) <= 15;
+    // percent% 확률로 블러핑 (기본 15%)
+    bool should_bluff(int percent) {
+        return std::uniform_int_distribution<int>(1, 100)(rng()) <= percent;
     }
 };
 
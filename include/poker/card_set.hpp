@@ -0,0 +1,106 @@
+#pragma once
+
+#include "card.hpp"
+#include "concepts.hpp"
+#include "deck.hpp"
+#include "hand.hpp"
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace poker {
+
+// 카드 인덱스: suit * 13 + (rank - 2)
+// detail::STANDARD_DECK 의 순서와 동일하다.
+constexpr int card_index(const Card& card) {
+    return static_cast<int>(card.suit) * 13 + (static_cast<int>(card.rank) - 2);
+}
+
+constexpr Card card_at(int index) {
+    return detail::STANDARD_DECK[static_cast<size_t>(index)];
+}
+
+// 52비트 카드 집합. 비트 i = card_at(i)
+class CardSet {
+public:
+    static constexpr std::uint64_t ALL_BITS = (std::uint64_t{1} << 52) - 1;
+
+    constexpr CardSet() = default;
+    constexpr explicit CardSet(std::uint64_t bits) : bits_(bits & ALL_BITS) {}
+
+    template<size_t N>
+    explicit CardSet(const Hand<N>& hand) {
+        for (auto& card : hand.cards()) insert(card);
+    }
+
+    template<CardLike... Cards>
+    static constexpr CardSet of(const Cards&... cards) {
+        CardSet set;
+        (set.insert(Card{cards.rank, cards.suit}), ...);
+        return set;
+    }
+
+    static constexpr CardSet full() { return CardSet{ALL_BITS}; }
+
+    constexpr std::uint64_t bits() const { return bits_; }
+    constexpr size_t size() const { return static_cast<size_t>(std::popcount(bits_)); }
+    constexpr bool empty() const { return bits_ == 0; }
+
+    constexpr bool contains(const Card& card) const { return contains_index(card_index(card)); }
+    constexpr bool contains_index(int i) const { return (bits_ >> i) & 1; }
+
+    constexpr void insert(const Card& card) { insert_index(card_index(card)); }
+    constexpr void insert_index(int i) { bits_ |= std::uint64_t{1} << i; }
+    constexpr void erase(const Card& card) { erase_index(card_index(card)); }
+    constexpr void erase_index(int i) { bits_ &= ~(std::uint64_t{1} << i); }
+
+    constexpr bool intersects(CardSet other) const { return (bits_ & other.bits_) != 0; }
+
+    // 해당 수트의 13비트 랭크 마스크 (비트 0 = Two)
+    constexpr std::uint16_t suit_mask(Suit suit) const {
+        return static_cast<std::uint16_t>((bits_ >> (static_cast<int>(suit) * 13)) & 0x1FFF);
+    }
+
+    template<typename F>
+    constexpr void for_each(F&& f) const {
+        for (std::uint64_t b = bits_; b; b &= b - 1) {
+            f(card_at(std::countr_zero(b)));
+        }
+    }
+
+    constexpr CardSet operator|(CardSet o) const { return CardSet{bits_ | o.bits_}; }
+    constexpr CardSet operator&(CardSet o) const { return CardSet{bits_ & o.bits_}; }
+    constexpr CardSet operator~() const { return CardSet{~bits_}; }
+    constexpr CardSet& operator|=(CardSet o) { bits_ |= o.bits_; return *this; }
+    constexpr CardSet& operator&=(CardSet o) { bits_ &= o.bits_; return *this; }
+
+    constexpr bool operator==(const CardSet&) const = default;
+
+private:
+    std::uint64_t bits_{0};
+};
+
+// CardSet → Hand<N> (카드 수가 정확히 N 장이어야 한다)
+template<size_t N>
+Hand<N> make_hand(CardSet cards) {
+    if (cards.size() != N) {
+        throw std::invalid_argument("CardSet size does not match hand size");
+    }
+    std::array<Card, N> picked{};
+    size_t i = 0;
+    cards.for_each([&](const Card& card) { picked[i++] = card; });
+    return [&]<size_t... I>(std::index_sequence<I...>) {
+        return Hand<N>(picked[I]...);
+    }(std::make_index_sequence<N>{});
+}
+
+} // namespace poker
+
+template<>
+struct std::hash<poker::CardSet> {
+    size_t operator()(const poker::CardSet& s) const noexcept {
+        return std::hash<std::uint64_t>{}(s.bits());
+    }
+};
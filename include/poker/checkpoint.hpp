@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define POKER_CHECKPOINT_MMAP 1
+#else
+#define POKER_CHECKPOINT_MMAP 0
+#endif
+
+namespace poker {
+
+namespace detail {
+
+    // FNV-1a (체크포인트 슬롯, 샤드 결과 파일 검증용)
+    inline std::uint64_t fnv1a(const std::byte* data, size_t size, std::uint64_t seed = 0) {
+        std::uint64_t h = 0xCBF29CE484222325ull ^ seed;
+        for (size_t i = 0; i < size; ++i) h = (h ^ static_cast<std::uint64_t>(data[i])) * 0x100000001B3ull;
+        return h;
+    }
+
+} // namespace detail
+
+// 체크포인트 내용을 만드는 쪽 (trivially copyable 값과 그 배열만)
+class CheckpointWriter {
+public:
+    template<typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoint values must be trivially copyable");
+        auto bytes = reinterpret_cast<const std::byte*>(&value);
+        bytes_.insert(bytes_.end(), bytes, bytes + sizeof(T));
+    }
+
+    template<typename T>
+    void put(const std::vector<T>& values) {
+        put(static_cast<std::uint64_t>(values.size()));
+        for (const auto& v : values) put(v);
+    }
+
+    std::span<const std::byte> bytes() const { return bytes_; }
+    void clear() { bytes_.clear(); }
+
+private:
+    std::vector<std::byte> bytes_;
+};
+
+// 읽는 쪽. 모자라거나 남으면 runtime_error (다른 버전/다른 설정의 파일)
+class CheckpointReader {
+public:
+    explicit CheckpointReader(std::span<const std::byte> bytes) : bytes_(bytes) {}
+
+    template<typename T>
+    T get() {
+        static_assert(std::is_trivially_copyable_v<T>, "Checkpoint values must be trivially copyable");
+        if (bytes_.size() - offset_ < sizeof(T)) throw std::runtime_error("Checkpoint is truncated");
+        T value;
+        std::memcpy(&value, bytes_.data() + offset_, sizeof(T));
+        offset_ += sizeof(T);
+        return value;
+    }
+
+    template<typename T>
+    std::vector<T> get_vector() {
+        auto count = get<std::uint64_t>();
+        if (count > (bytes_.size() - offset_) / sizeof(T)) throw std::runtime_error("Checkpoint is truncated");
+        std::vector<T> values(static_cast<size_t>(count));
+        for (auto& v : values) v = get<T>();
+        return values;
+    }
+
+    bool done() const { return offset_ == bytes_.size(); }
+
+private:
+    std::span<const std::byte> bytes_;
+    size_t offset_{0};
+};
+
+/*
+메모리 맵 체크포인트 파일 (슬롯 2개 번갈아 쓰기)
+
+    CheckpointFile file("sim.ckpt", 1 << 20);
+    if (auto saved = file.load()) resume_from(*saved);
+    ...
+    file.save(writer.bytes());   // memcpy 만 하고 돌아온다. msync/fsync 는 백그라운드 스레드
+
+파일 = 헤더 + 슬롯 2개. 슬롯 = (세대, 크기, 체크섬) + 본문
+1. save 는 마지막으로 디스크에 닿은 슬롯이 아닌 쪽에 본문과 헤더를 쓰고 플러시 스레드에 넘긴다
+2. 플러시 스레드가 그 슬롯을 msync + fsync. 둘 다 성공해야 그 슬롯이 최신이 된다
+   다음 save 는 이게 끝날 때까지만 기다린다 (디스크에 닿은 마지막 슬롯은 절대 덮어쓰지 않는다)
+3. load 는 체크섬이 맞는 슬롯 중 세대가 가장 큰 것. 쓰다가 죽은 슬롯은 체크섬에서 걸러진다
+플러시가 실패하면 (ENOSPC, EIO 등) errno 를 남기고, 다음 save 나 wait 가 std::system_error 로 던진다.
+최신 슬롯은 그대로라 다음 save 는 실패한 슬롯을 다시 쓴다.
+mmap 이 없는 플랫폼은 같은 구조를 메모리에 두고 슬롯 영역만 파일에 다시 쓴다 (fsync 없음).
+*/
+class CheckpointFile {
+public:
+    CheckpointFile(std::string path, size_t capacity) : path_(std::move(path)) {
+        open(capacity);
+        flusher_ = std::thread([this] { run(); });
+    }
+
+    ~CheckpointFile() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        changed_.notify_all();
+        flusher_.join();
+        close();
+    }
+
+    CheckpointFile(const CheckpointFile&) = delete;
+    CheckpointFile& operator=(const CheckpointFile&) = delete;
+
+    // 가장 최근의 온전한 체크포인트 (없으면 nullopt)
+    std::optional<std::vector<std::byte>> load() const {
+        if (latest_ < 0) return std::nullopt;
+        const auto& header = slot_header(static_cast<size_t>(latest_));
+        auto body = slot_body(static_cast<size_t>(latest_));
+        return std::vector<std::byte>(body, body + header.size);
+    }
+
+    void save(std::span<const std::byte> payload) {
+        if (payload.size() > capacity_) throw std::length_error("Checkpoint is larger than the slot capacity");
+        std::unique_lock lock(mutex_);
+        written_.wait(lock, [this] { return pending_ < 0; });   // 이전 save 가 디스크에 닿을 때까지
+        throw_if_failed();
+        const size_t slot = latest_ == 0 ? 1 : 0;
+        lock.unlock();
+
+        auto& header = slot_header(slot);
+        std::memcpy(slot_body(slot), payload.data(), payload.size());
+        header.generation = ++generation_;
+        header.size = payload.size();
+        header.checksum = checksum(header.generation, slot_body(slot), payload.size());
+
+        lock.lock();
+        pending_ = static_cast<int>(slot);
+        lock.unlock();
+        changed_.notify_all();
+    }
+
+    // 마지막 save 가 디스크에 닿을 때까지 기다린다. 플러시가 실패했으면 std::system_error
+    void wait() {
+        std::unique_lock lock(mutex_);
+        written_.wait(lock, [this] { return pending_ < 0; });
+        throw_if_failed();
+    }
+
+    std::uint64_t generation() const { return generation_; }
+    size_t capacity() const { return capacity_; }
+    const std::string& path() const { return path_; }
+
+private:
+    static constexpr std::array<char, 8> MAGIC{'P', 'K', 'R', 'C', 'K', 'P', 'T', '1'};
+    static constexpr size_t HEADER_BYTES = 64;
+
+    struct FileHeader {
+        std::array<char, 8> magic;
+        std::uint64_t capacity;
+    };
+
+    struct SlotHeader {
+        std::uint64_t generation;
+        std::uint64_t size;
+        std::uint64_t checksum;
+    };
+
+    std::string path_;
+    size_t capacity_{0};
+    std::byte* base_{nullptr};      // 파일 전체 (mmap 또는 image_)
+    size_t file_bytes_{0};
+    std::uint64_t generation_{0};
+    int latest_{-1};                // 디스크에 닿은 가장 최근 슬롯 (플러시가 성공해야 바뀐다)
+#if POKER_CHECKPOINT_MMAP
+    int fd_{-1};
+#else
+    std::vector<std::byte> image_;
+#endif
+
+    // save ↔ 플러시 스레드
+    std::mutex mutex_;
+    std::condition_variable changed_;
+    std::condition_variable written_;
+    int pending_{-1};               // 플러시를 기다리는 슬롯
+    bool stopping_{false};
+    std::atomic<int> error_{0};     // 아직 알리지 않은 플러시 실패의 errno
+    std::thread flusher_;
+
+    size_t slot_offset(size_t slot) const { return HEADER_BYTES + slot * (HEADER_BYTES + capacity_); }
+    SlotHeader& slot_header(size_t slot) const {
+        return *reinterpret_cast<SlotHeader*>(base_ + slot_offset(slot));
+    }
+    std::byte* slot_body(size_t slot) const { return base_ + slot_offset(slot) + HEADER_BYTES; }
+
+    // 세대를 섞어서 다른 세대의 본문과 헤더가 섞인 것도 걸러낸다
+    static std::uint64_t checksum(std::uint64_t generation, const std::byte* data, size_t size) {
+        return detail::fnv1a(data, size, generation);
+    }
+
+    // 이미 있는 파일이면 그 슬롯 크기를 쓰고, 더 큰 슬롯이 필요하면 최근 체크포인트를 옮겨 담아 늘린다
+    void open(size_t capacity) {
+        capacity = (std::max<size_t>(capacity, 1) + HEADER_BYTES - 1) / HEADER_BYTES * HEADER_BYTES;
+        FileHeader header{};
+        size_t existing = 0;
+        {
+            std::ifstream in(path_, std::ios::binary);
+            if (in.read(reinterpret_cast<char*>(&header), sizeof(header)) && header.magic == MAGIC) {
+                existing = static_cast<size_t>(header.capacity);
+            }
+        }
+
+        std::optional<std::vector<std::byte>> carried;
+        if (existing) {
+            map(existing);
+            find_latest();
+            if (existing >= capacity) return;
+            carried = load();
+            close();
+            latest_ = -1;
+        }
+
+        map(capacity);
+        std::memset(base_, 0, file_bytes_);
+        header = FileHeader{MAGIC, capacity_};
+        std::memcpy(base_, &header, sizeof(header));
+        if (carried) {
+            auto& slot = slot_header(0);
+            std::memcpy(slot_body(0), carried->data(), carried->size());
+            slot.generation = generation_;
+            slot.size = carried->size();
+            slot.checksum = checksum(generation_, slot_body(0), carried->size());
+            latest_ = 0;
+        }
+        if (int error = sync(0, file_bytes_)) {
+            close();
+            throw std::system_error(error, std::generic_category(), "Cannot flush checkpoint file " + path_);
+        }
+    }
+
+    void map(size_t capacity) {
+        capacity_ = capacity;
+        file_bytes_ = HEADER_BYTES + 2 * (HEADER_BYTES + capacity_);
+#if POKER_CHECKPOINT_MMAP
+        fd_ = ::open(path_.c_str(), O_RDWR | O_CREAT, 0644);
+        if (fd_ < 0) throw std::runtime_error("Cannot open checkpoint file " + path_);
+        struct stat st{};
+        if (::fstat(fd_, &st) != 0 || (static_cast<size_t>(st.st_size) < file_bytes_ &&
+                                       ::ftruncate(fd_, static_cast<off_t>(file_bytes_)) != 0)) {
+            ::close(fd_);
+            throw std::runtime_error("Cannot size checkpoint file " + path_);
+        }
+        void* mapping = ::mmap(nullptr, file_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd_);
+            throw std::runtime_error("Cannot map checkpoint file " + path_);
+        }
+        base_ = static_cast<std::byte*>(mapping);
+#else
+        image_.assign(file_bytes_, std::byte{0});
+        std::ifstream in(path_, std::ios::binary);
+        if (in) in.read(reinterpret_cast<char*>(image_.data()), static_cast<std::streamsize>(file_bytes_));
+        base_ = image_.data();
+#endif
+    }
+
+    // 온전한 슬롯 중 세대가 큰 쪽
+    void find_latest() {
+        for (size_t slot = 0; slot < 2; ++slot) {
+            const auto& s = slot_header(slot);
+            if (s.generation == 0 || s.size > capacity_) continue;
+            if (checksum(s.generation, slot_body(slot), s.size) != s.checksum) continue;
+            if (s.generation > generation_) {
+                generation_ = s.generation;
+                latest_ = static_cast<int>(slot);
+            }
+        }
+    }
+
+    void close() {
+#if POKER_CHECKPOINT_MMAP
+        if (base_) ::munmap(base_, file_bytes_);
+        if (fd_ >= 0) ::close(fd_);
+        fd_ = -1;
+#endif
+        base_ = nullptr;
+    }
+
+    // [offset, offset + size) 를 디스크까지. 성공하면 0, 실패하면 errno
+    int sync(size_t offset, size_t size) {
+#if POKER_CHECKPOINT_MMAP
+        // msync 는 페이지 경계에서 시작해야 한다
+        const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        const size_t begin = offset / page * page;
+        if (::msync(base_ + begin, offset + size - begin, MS_SYNC) != 0) return errno;
+        if (::fsync(fd_) != 0) return errno;
+        return 0;
+#else
+        std::fstream out(path_, std::ios::binary | std::ios::in | std::ios::out);
+        if (!out) out.open(path_, std::ios::binary | std::ios::out);
+        out.seekp(static_cast<std::streamoff>(offset));
+        out.write(reinterpret_cast<const char*>(base_ + offset), static_cast<std::streamsize>(size));
+        out.flush();
+        return out ? 0 : EIO;
+#endif
+    }
+
+    // 플러시 실패는 한 번만 알린다 (다음 save 는 다시 시도한다)
+    void throw_if_failed() {
+        if (int error = error_.exchange(0)) {
+            throw std::system_error(error, std::generic_category(), "Cannot flush checkpoint file " + path_);
+        }
+    }
+
+    void run() {
+        std::unique_lock lock(mutex_);
+        while (true) {
+            changed_.wait(lock, [this] { return pending_ >= 0 || stopping_; });
+            if (pending_ < 0) return;
+            const auto slot = static_cast<size_t>(pending_);
+            lock.unlock();
+            const int error = sync(slot_offset(slot), HEADER_BYTES + slot_header(slot).size);
+            lock.lock();
+            if (error) {
+                error_.store(error);
+            } else {
+                latest_ = static_cast<int>(slot);
+            }
+            pending_ = -1;
+            written_.notify_all();
+        }
+    }
+};
+
+} // namespace poker
@@ -5,6 +5,7 @@
 #include <random>
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <stdexcept>
 
 namespace poker {
@@ -30,6 +31,7 @@ namespace detail {
 class Deck {
 public:
     Deck() = default;
+    explicit Deck(std::uint32_t seed) : rng_(seed) {}
     ~Deck() = default;
 
     Deck(const Deck&) = delete;
@@ -39,6 +41,22 @@ public:
         std::shuffle(cards_.begin(), cards_.end(), rng_);
     }
 
+    // 같은 시드면 reset() + shuffle() 순서가 항상 같다 (재현/미러 딜용)
+    void seed(std::uint32_t value) {
+        rng_.seed(value);
+    }
+
+    // 미리 섞어 둔 순서를 그대로 쓴다 (shuffle 대신, DeckBatch 등)
+    void load(const std::array<Card, 52>& order) {
+        cards_ = order;
+        top_index_ = 0;
+    }
+
+    // 현재 카드 순서 (GameState 로 옮길 때)
+    const std::array<Card, 52>& cards() const {
+        return cards_;
+    }
+
     size_t remaining() const {
         return 52 - top_index_;
     }
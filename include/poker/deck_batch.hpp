@@ -0,0 +1,188 @@
+#pragma once
+
+#include "packed.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace poker {
+
+namespace detail {
+
+    // Philox4x32-10 (Salmon et al., Random123): (카운터, 키) → 32비트 난수 4개
+    // 상태가 없어서 덱 번호만 알면 어느 스레드에서 어떤 순서로 만들어도 같은 결과
+    struct Philox {
+        static constexpr std::uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+        static constexpr std::uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+
+        static constexpr std::array<std::uint32_t, 4> generate(std::array<std::uint32_t, 4> c,
+                                                               std::uint32_t k0, std::uint32_t k1) {
+            for (int round = 0; round < 10; ++round) {
+                std::uint64_t p0 = std::uint64_t{M0} * c[0];
+                std::uint64_t p1 = std::uint64_t{M1} * c[2];
+                c = {static_cast<std::uint32_t>(p1 >> 32) ^ c[1] ^ k0, static_cast<std::uint32_t>(p1),
+                     static_cast<std::uint32_t>(p0 >> 32) ^ c[3] ^ k1, static_cast<std::uint32_t>(p0)};
+                k0 += W0;
+                k1 += W1;
+            }
+            return c;
+        }
+
+        // 같은 키로 카운터 L 개를 한꺼번에 (워드별 배열이라 레인 루프가 SIMD 곱셈으로 벡터화된다)
+        template<size_t L>
+        static constexpr void generate_lanes(std::array<std::array<std::uint32_t, L>, 4>& c,
+                                             std::uint32_t k0, std::uint32_t k1) {
+            for (int round = 0; round < 10; ++round) {
+                for (size_t l = 0; l < L; ++l) {
+                    std::uint64_t p0 = std::uint64_t{M0} * c[0][l];
+                    std::uint64_t p1 = std::uint64_t{M1} * c[2][l];
+                    auto c1 = c[1][l], c3 = c[3][l];
+                    c[0][l] = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                    c[1][l] = static_cast<std::uint32_t>(p1);
+                    c[2][l] = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                    c[3][l] = static_cast<std::uint32_t>(p0);
+                }
+                k0 += W0;
+                k1 += W1;
+            }
+        }
+    };
+
+    // Lemire 의 곱셈-시프트로 [0, n) 을 뽑을 때 버려야 하는 하위 값 한계. 나눗셈은 컴파일 타임에만
+    // 16비트: 2^16 mod n (n <= 52 라 기각 확률 0.1% 미만), 32비트: 2^32 mod n (재추출용)
+    inline constexpr auto LEMIRE_THRESHOLD_16 = [] {
+        std::array<std::uint16_t, 53> table{};
+        for (std::uint32_t n = 1; n < table.size(); ++n) table[n] = static_cast<std::uint16_t>(65536u % n);
+        return table;
+    }();
+    inline constexpr auto LEMIRE_THRESHOLD = [] {
+        std::array<std::uint32_t, 53> table{};
+        for (std::uint32_t n = 1; n < table.size(); ++n) table[n] = static_cast<std::uint32_t>(-n) % n;
+        return table;
+    }();
+
+    inline constexpr auto IDENTITY_DECK = [] {
+        std::array<std::uint8_t, 52> deck{};
+        for (size_t i = 0; i < deck.size(); ++i) deck[i] = static_cast<std::uint8_t>(i);
+        return deck;
+    }();
+
+} // namespace detail
+
+/*
+여러 테이블/표본용 덱을 한 번에 섞는 버퍼
+
+    DeckBatch batch(tables);            // 덱 tables 개, 52장씩
+    batch.generate(seed, step * tables); // 덱 번호 = first + k
+    game.start_round(batch.deck(t));
+
+덱 k 는 (seed, first + k) 카운터로 정해지므로 같은 번호면 언제 만들어도 같은 순서다.
+앞 cards 장만 필요하면 (보드 런아웃 등) 정방향 Fisher–Yates 를 cards 번만 돈다.
+
+한 번에 LANES 개 덱을 구조체-배열(SoA) 로 묶어서
+1. Philox 카운터 블록을 레인 방향으로 돌리고 (레인끼리 독립이라 벡터화된다)
+2. 16비트씩 Lemire 곱셈-시프트로 [i, 52) 인덱스를 만든 뒤 (런타임 나눗셈 없음, 드문 기각만 따로)
+3. 여러 덱의 교환을 번갈아 한다
+*/
+class DeckBatch {
+public:
+    static constexpr size_t LANES = 8;
+
+    explicit DeckBatch(size_t decks = 0, size_t cards = 52)
+        : decks_(decks), cards_(cards), buffer_(decks * cards)
+    {
+        if (cards == 0 || cards > 52) throw std::invalid_argument("Cards per deck must be between 1 and 52");
+    }
+
+    void generate(std::uint64_t seed, std::uint64_t first_deck = 0) {
+        const auto k0 = static_cast<std::uint32_t>(seed);
+        const auto k1 = static_cast<std::uint32_t>(seed >> 32);
+        // 교환 한 번에 16비트면 충분하다: 32비트 워드 하나로 두 번, Philox 블록 하나로 여덟 번
+        const size_t blocks = (cards_ + 7) / 8;
+
+        std::array<std::array<std::uint32_t, LANES>, 28> random{};
+        for (size_t base = 0; base < decks_; base += LANES) {
+            // 1. 레인별 난수: 카운터 = (덱 번호 하위, 상위, 블록, 0)
+            for (size_t b = 0; b < blocks; ++b) {
+                std::array<std::array<std::uint32_t, LANES>, 4> counter;
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    std::uint64_t deck = first_deck + base + lane;
+                    counter[0][lane] = static_cast<std::uint32_t>(deck);
+                    counter[1][lane] = static_cast<std::uint32_t>(deck >> 32);
+                    counter[2][lane] = static_cast<std::uint32_t>(b);
+                    counter[3][lane] = 0;
+                }
+                detail::Philox::generate_lanes(counter, k0, k1);
+                for (size_t w = 0; w < 4; ++w) random[b * 4 + w] = counter[w];
+            }
+
+            // 2. [i, 52) 인덱스 (레인 방향으로 벡터화, 기각은 표시만 해 두고 드물게 따로)
+            std::array<std::array<std::uint8_t, LANES>, 52> pick;
+            auto bits16 = [&](size_t i, size_t lane) {
+                return (random[i / 2][lane] >> (16 * (i % 2))) & 0xFFFFu;
+            };
+            for (size_t i = 0; i < cards_; ++i) {
+                auto n = static_cast<std::uint32_t>(52 - i);
+                bool rejected = false;
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    std::uint32_t m = bits16(i, lane) * n;
+                    pick[i][lane] = static_cast<std::uint8_t>(i + (m >> 16));
+                    rejected |= (m & 0xFFFFu) < detail::LEMIRE_THRESHOLD_16[n];
+                }
+                if (!rejected) continue;
+                for (size_t lane = 0; lane < LANES; ++lane) {
+                    std::uint32_t m16 = bits16(i, lane) * n;
+                    if ((m16 & 0xFFFFu) < detail::LEMIRE_THRESHOLD_16[n]) {
+                        auto m = redraw(first_deck + base + lane, i, n, k0, k1);
+                        pick[i][lane] = static_cast<std::uint8_t>(i + (m >> 32));
+                    }
+                }
+            }
+
+            // 3. 교환. 덱 LANES 개를 번갈아 돌려서 서로 독립인 교환이 겹쳐 실행되게 한다
+            std::array<std::array<std::uint8_t, 52>, LANES> decks;
+            decks.fill(detail::IDENTITY_DECK);
+            for (size_t i = 0; i < cards_; ++i) {
+                for (size_t lane = 0; lane < LANES; ++lane) std::swap(decks[lane][i], decks[lane][pick[i][lane]]);
+            }
+            const size_t lanes = std::min(LANES, decks_ - base);
+            for (size_t lane = 0; lane < lanes; ++lane) {
+                std::memcpy(buffer_.data() + (base + lane) * cards_, decks[lane].data(), cards_);
+            }
+        }
+    }
+
+    std::span<const PackedCard> deck(size_t k) const {
+        if (k >= decks_) throw std::out_of_range("Deck index out of range");
+        return {buffer_.data() + k * cards_, cards_};
+    }
+
+    size_t size() const { return decks_; }
+    size_t cards_per_deck() const { return cards_; }
+    const PackedCard* data() const { return buffer_.data(); }
+
+private:
+    size_t decks_;
+    size_t cards_;
+    std::vector<PackedCard> buffer_;   // 덱 k 의 카드 = [k * cards_, (k + 1) * cards_)
+
+    // 기각된 경우: 같은 덱의 예비 카운터(4번째 워드)로 32비트 난수를 새로 뽑는다
+    static std::uint64_t redraw(std::uint64_t deck, size_t i, std::uint32_t n,
+                                std::uint32_t k0, std::uint32_t k1) {
+        for (std::uint32_t attempt = 1;; ++attempt) {
+            auto r = detail::Philox::generate({static_cast<std::uint32_t>(deck),
+                                               static_cast<std::uint32_t>(deck >> 32),
+                                               static_cast<std::uint32_t>(i), attempt}, k0, k1);
+            std::uint64_t m = std::uint64_t{r[0]} * n;
+            if (static_cast<std::uint32_t>(m) >= detail::LEMIRE_THRESHOLD[n]) return m;
+        }
+    }
+};
+
+static_assert(sizeof(PackedCard) == 1, "DeckBatch copies decks as raw bytes");
+
+} // namespace poker
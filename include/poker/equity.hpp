@@ -0,0 +1,271 @@
+#pragma once
+
+#include "card_set.hpp"
+#include "evaluator.hpp"
+#include "incremental_hand.hpp"
+#include "parallel.hpp"
+#include "range.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace poker {
+
+struct EquityResult {
+    double win{0.0};
+    double tie{0.0};
+    double lose{0.0};
+    std::uint64_t samples{0};   // 평가한 (hero, villain, 보드) 조합 수
+    bool exhaustive{false};
+
+    double equity() const { return win + tie / 2.0; }
+};
+
+struct EquityOptions {
+    size_t board_size{0};                     // 0 = 5카드 드로우, 5 = 홀덤
+    CardSet board{};                          // 이미 공개된 보드 카드
+    CardSet dead{};                           // 제외할 카드
+    std::uint64_t max_exhaustive{2'000'000};  // 예상 평가 횟수가 이 이하면 전수 조사
+    std::uint64_t samples{200'000};           // 몬테카를로 표본 수
+    unsigned threads{0};                      // 0 = 하드웨어 스레드 수
+    std::uint64_t seed{0};                    // 0 = random_device
+};
+
+// 몬테카를로 표본 묶음 크기. 묶음 b 는 seed + b * 0x9E3779B97F4A7C15 로 시드를 받으므로
+// seed 를 첫 묶음만큼 밀면 큰 실행의 일부 묶음만 따로 돌릴 수 있다 (샤드)
+inline constexpr std::uint64_t EQUITY_BATCH = 4096;
+inline constexpr std::uint64_t EQUITY_BATCH_STRIDE = 0x9E3779B97F4A7C15ull;
+
+namespace detail {
+
+    constexpr std::uint64_t choose(std::uint64_t n, std::uint64_t k) {
+        if (k > n) return 0;
+        std::uint64_t r = 1;
+        for (std::uint64_t i = 1; i <= k; ++i) r = r * (n - k + i) / i;
+        return r;
+    }
+
+    // avail 에서 k장을 고르는 모든 조합을 f(CardSet) 로 전달
+    template<typename F>
+    void for_each_combination(CardSet avail, size_t k, F&& f) {
+        int idx[52];
+        int n = 0;
+        for (std::uint64_t b = avail.bits(); b; b &= b - 1) idx[n++] = std::countr_zero(b);
+        if (k == 0) { f(CardSet{}); return; }
+        if (static_cast<int>(k) > n) return;
+
+        int pos[5];
+        for (size_t i = 0; i < k; ++i) pos[i] = static_cast<int>(i);
+        while (true) {
+            CardSet set;
+            for (size_t i = 0; i < k; ++i) set.insert_index(idx[pos[i]]);
+            f(set);
+
+            int i = static_cast<int>(k) - 1;
+            while (i >= 0 && pos[i] == n - static_cast<int>(k) + i) --i;
+            if (i < 0) return;
+            ++pos[i];
+            for (size_t j = static_cast<size_t>(i) + 1; j < k; ++j) pos[j] = pos[j - 1] + 1;
+        }
+    }
+
+    // 보드 카드를 하나씩 두 핸드에 더해가며 깊이 우선으로 모든 런아웃을 방문한다.
+    // 같은 앞부분(플랍 등)을 공유하는 런아웃은 상태를 다시 만들지 않는다.
+    template<typename F>
+    void walk_runouts(const int* idx, int n, size_t k, IncrementalHand& a, IncrementalHand& b, F&& f) {
+        if (k == 0) { f(a, b); return; }
+        for (int i = 0; i + static_cast<int>(k) <= n; ++i) {
+            a.add_index(idx[i]);
+            b.add_index(idx[i]);
+            walk_runouts(idx + i + 1, n - i - 1, k - 1, a, b, f);
+            a.remove_index(idx[i]);
+            b.remove_index(idx[i]);
+        }
+    }
+
+    // 워커별 누적값. false sharing 방지를 위해 캐시라인 정렬
+    struct alignas(64) EquityAccumulator {
+        double win{0.0};
+        double tie{0.0};
+        double lose{0.0};
+        std::uint64_t samples{0};
+    };
+
+} // namespace detail
+
+/*
+레인지 vs 레인지 에퀴티
+
+1. 보드/데드 카드와 겹치는 조합 제거
+2. (hero 조합 × villain 조합 × 남은 보드) 평가 횟수가 max_exhaustive 이하면 전수 조사,
+   아니면 가중치 비례로 조합을 뽑는 몬테카를로
+3. hero 조합(전수) 또는 표본 묶음(몬테카를로) 단위로 여러 코어에 분산
+*/
+inline EquityResult equity(const Range& hero_range, const Range& villain_range,
+                           const EquityOptions& options = {}) {
+    if (options.board.size() > options.board_size) {
+        throw std::invalid_argument("Board has more cards than board_size");
+    }
+    if (options.board.intersects(options.dead)) {
+        throw std::invalid_argument("Board and dead cards overlap");
+    }
+
+    CardSet blocked = options.board | options.dead;
+    Range hero = hero_range.without(blocked);
+    Range villain = villain_range.without(blocked);
+    if (hero.empty() || villain.empty()) {
+        throw std::invalid_argument("Range is empty after removing board and dead cards");
+    }
+
+    const size_t missing = options.board_size - options.board.size();
+    const size_t combo_cards = hero.combos()[0].cards.size() + villain.combos()[0].cards.size();
+    const std::uint64_t boards = detail::choose(52 - blocked.size() - combo_cards, missing);
+    const std::uint64_t estimate = static_cast<std::uint64_t>(hero.size()) * villain.size() * boards;
+
+    unsigned threads = options.threads ? options.threads : default_thread_count();
+    std::vector<detail::EquityAccumulator> acc(threads);
+    EquityResult result;
+
+    if (estimate <= options.max_exhaustive) {
+        result.exhaustive = true;
+
+        // 보드가 다 나와 있으면 조합별 HandValue 를 한 번만 계산 (4바이트로 압축해서 보관)
+        std::vector<std::uint32_t> villain_values;
+        if (missing == 0) {
+            villain_values.reserve(villain.size());
+            for (auto& v : villain.combos()) villain_values.push_back(evaluate(v.cards | options.board).packed());
+        }
+
+        parallel_for(hero.size(), threads, [&](size_t i, unsigned w) {
+            auto& a = acc[w];
+            const auto& h = hero.combos()[i];
+            std::uint32_t hero_value = 0;
+            if (missing == 0) hero_value = evaluate(h.cards | options.board).packed();
+
+            for (size_t j = 0; j < villain.size(); ++j) {
+                const auto& v = villain.combos()[j];
+                if (h.cards.intersects(v.cards)) continue;
+                double weight = h.weight * v.weight;
+
+                if (missing == 0) {
+                    auto cmp = hero_value <=> villain_values[j];
+                    if (cmp > 0) a.win += weight;
+                    else if (cmp < 0) a.lose += weight;
+                    else a.tie += weight;
+                    ++a.samples;
+                    continue;
+                }
+
+                std::uint64_t win = 0, tie = 0, lose = 0;
+                int idx[52];
+                int n = 0;
+                CardSet avail = ~(blocked | h.cards | v.cards);
+                for (std::uint64_t b = avail.bits(); b; b &= b - 1) idx[n++] = std::countr_zero(b);
+
+                IncrementalHand hero_hand{h.cards | options.board};
+                IncrementalHand villain_hand{v.cards | options.board};
+                detail::walk_runouts(idx, n, missing, hero_hand, villain_hand,
+                    [&](const IncrementalHand& hh, const IncrementalHand& vh) {
+                        auto cmp = compare(hh, vh);
+                        if (cmp > 0) ++win;
+                        else if (cmp < 0) ++lose;
+                        else ++tie;
+                    });
+                double total = static_cast<double>(win + tie + lose);
+                a.win += weight * win / total;
+                a.tie += weight * tie / total;
+                a.lose += weight * lose / total;
+                a.samples += win + tie + lose;
+            }
+        });
+    } else {
+        // 가중치 비례 추출용 누적 분포 (워커끼리 읽기 전용으로 공유)
+        auto cumulative = [](const Range& range) {
+            std::vector<double> cdf;
+            double sum = 0.0;
+            for (auto& c : range.combos()) cdf.push_back(sum += c.weight);
+            return cdf;
+        };
+        const auto hero_cdf = cumulative(hero);
+        const auto villain_cdf = cumulative(villain);
+
+        // 서로 겹치지 않는 조합이 하나도 없으면 재추출이 끝나지 않는다
+        bool any_pair = false;
+        for (auto& h : hero.combos()) {
+            for (auto& v : villain.combos()) {
+                if (!h.cards.intersects(v.cards)) { any_pair = true; break; }
+            }
+            if (any_pair) break;
+        }
+        if (!any_pair) throw std::invalid_argument("Every hero combo conflicts with every villain combo");
+
+        std::uint64_t seed = options.seed ? options.seed : std::random_device{}();
+
+        // 표본을 고정 크기 묶음으로 나눠서 스레드 수와 무관하게 같은 시드면 같은 결과
+        const std::uint64_t batches = (options.samples + EQUITY_BATCH - 1) / EQUITY_BATCH;
+
+        parallel_for(batches, threads, [&](size_t b, unsigned w) {
+            auto& a = acc[w];
+            std::mt19937_64 rng{seed + b * EQUITY_BATCH_STRIDE};
+            std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+            // 64비트 난수 하나를 32비트 두 개로 나눠 곱셈-시프트로 0~51 (나눗셈 없음)
+            std::uint64_t bits = 0;
+            int spare = 0;
+            auto pick_card = [&] {
+                if (spare == 0) { bits = rng(); spare = 2; }
+                auto half = static_cast<std::uint32_t>(bits);
+                bits >>= 32;
+                --spare;
+                return static_cast<int>((std::uint64_t{half} * 52) >> 32);
+            };
+
+            auto pick = [&](const Range& range, const std::vector<double>& cdf) {
+                auto it = std::upper_bound(cdf.begin(), cdf.end(), unit(rng) * cdf.back());
+                auto i = std::min<size_t>(static_cast<size_t>(it - cdf.begin()), cdf.size() - 1);
+                return range.combos()[i].cards;
+            };
+
+            std::uint64_t count = std::min(EQUITY_BATCH, options.samples - b * EQUITY_BATCH);
+            for (std::uint64_t s = 0; s < count;) {
+                CardSet h = pick(hero, hero_cdf);
+                CardSet v = pick(villain, villain_cdf);
+                if (h.intersects(v)) continue;  // 충돌하는 조합은 다시 뽑는다
+
+                CardSet board = options.board;
+                CardSet used = blocked | h | v;
+                while (board.size() < options.board_size) {
+                    int c = pick_card();
+                    if (used.contains_index(c)) continue;
+                    used.insert_index(c);
+                    board.insert_index(c);
+                }
+
+                auto cmp = evaluate(h | board) <=> evaluate(v | board);
+                if (cmp > 0) a.win += 1.0;
+                else if (cmp < 0) a.lose += 1.0;
+                else a.tie += 1.0;
+                ++a.samples;
+                ++s;
+            }
+        });
+    }
+
+    for (auto& a : acc) {
+        result.win += a.win;
+        result.tie += a.tie;
+        result.lose += a.lose;
+        result.samples += a.samples;
+    }
+    double total = result.win + result.tie + result.lose;
+    if (total > 0.0) {
+        result.win /= total;
+        result.tie /= total;
+        result.lose /= total;
+    }
+    return result;
+}
+
+} // namespace poker
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "card_set.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+
+namespace poker {
+
+struct EquityCacheStats {
+    std::uint64_t hits{0};
+    std::uint64_t misses{0};
+    std::uint64_t insertions{0};
+    std::uint64_t evictions{0};     // 다른 키를 밀어낸 삽입
+
+    double hit_rate() const {
+        auto lookups = hits + misses;
+        return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+    }
+};
+
+/*
+스레드/테이블이 같이 쓰는 고정 크기 에퀴티 캐시
+
+    auto& cache = EquityCache::shared();
+    double e = cache.get(EquityCache::key(cards, opponents), [&] { return slow_equity(cards, opponents); });
+
+키 = 수트 동형 정규형 (수트 마스크 4개를 정렬) + 상대 수 + 계산 종류. 수트만 바꾼 핸드는 같은 칸을 쓴다.
+칸을 샤드로 나누고 샤드 안에서는 키 해시 위치부터 PROBE 칸만 본다 (개방 주소법, 삭제 없음).
+- 읽기: 칸마다 seqlock. 순번이 짝수이고 읽기 전후로 같으면 (키, 값) 이 한 번에 쓴 것. 락 없음
+- 쓰기: 순번을 CAS 로 홀수로 만든 쪽만 쓴다 (다른 스레드가 쓰는 중이면 이번 삽입은 포기해도 된다)
+- 교체: 빈 칸이 없으면 CLOCK. 히트하면 참조 비트를 세우고, 교체할 때 샤드의 시계 바늘 위치부터
+  참조 비트를 지우며 돌다가 비트가 꺼진 칸을 내보낸다
+메모리는 만들 때 정한 칸 수 × 32바이트로 고정. 카운터는 샤드마다 따로 둬서 캐시라인을 덜 다툰다.
+*/
+class EquityCache {
+public:
+    static constexpr size_t PROBE = 8;     // 키 하나가 들어갈 수 있는 칸 수
+
+    explicit EquityCache(size_t capacity = 1 << 16, size_t shards = 16)
+        : shard_count_(std::bit_ceil(std::max<size_t>(shards, 1))),
+          shard_slots_(std::bit_ceil(std::max(capacity / shard_count_, PROBE))),
+          shard_shift_(64 - std::countr_zero(shard_count_)),
+          slots_(std::make_unique<Slot[]>(shard_count_ * shard_slots_)),
+          shards_(std::make_unique<Shard[]>(shard_count_))
+    {}
+
+    EquityCache(const EquityCache&) = delete;
+    EquityCache& operator=(const EquityCache&) = delete;
+
+    // 프로세스 전체가 같이 쓰는 캐시 (262144칸, 8MB. 5장 핸드의 수트 동형 134,459개가 상대 수 두 가지쯤 들어간다)
+    static EquityCache& shared() {
+        static EquityCache cache(1 << 18, 64);
+        return cache;
+    }
+
+    // kind = 계산 종류 (0~15). 같은 카드라도 다른 계산이면 다른 값을 넣는다
+    static std::uint64_t key(CardSet cards, size_t opponents, std::uint8_t kind = 0) {
+        std::array<std::uint16_t, 4> masks{cards.suit_mask(Suit::Clubs), cards.suit_mask(Suit::Diamonds),
+                                           cards.suit_mask(Suit::Hearts), cards.suit_mask(Suit::Spades)};
+        std::sort(masks.begin(), masks.end(), std::greater<>{});
+        std::uint64_t packed = 0;
+        for (auto m : masks) packed = (packed << 13) | m;
+        return VALID | (std::uint64_t{kind & 0xFu} << 59) | (std::uint64_t{std::min<size_t>(opponents, 127)} << 52) | packed;
+    }
+
+    std::optional<double> find(std::uint64_t key) {
+        const auto h = hash(key);
+        auto& shard = shards_[shard_of(h)];
+        Slot* slots = slots_.get() + shard_of(h) * shard_slots_;
+        const size_t start = static_cast<size_t>(h) & (shard_slots_ - 1);
+
+        for (size_t i = 0; i < PROBE; ++i) {
+            auto& slot = slots[(start + i) & (shard_slots_ - 1)];
+            auto [stored, value, stable] = read(slot);
+            if (!stable) continue;      // 쓰는 중인 칸은 건너뛴다 (그 키라면 미스로 친다)
+            if (stored == key) {
+                if (!slot.referenced.load(std::memory_order_relaxed)) {
+                    slot.referenced.store(1, std::memory_order_relaxed);
+                }
+                shard.hits.fetch_add(1, std::memory_order_relaxed);
+                return std::bit_cast<double>(value);
+            }
+            if (stored == 0) break;     // 삭제가 없으므로 빈 칸 뒤에는 이 키가 없다
+        }
+        shard.misses.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    void insert(std::uint64_t key, double value) {
+        if ((key & VALID) == 0) throw std::invalid_argument("EquityCache keys come from EquityCache::key");
+        const auto h = hash(key);
+        auto& shard = shards_[shard_of(h)];
+        Slot* slots = slots_.get() + shard_of(h) * shard_slots_;
+        const size_t start = static_cast<size_t>(h) & (shard_slots_ - 1);
+        auto at = [&](size_t i) -> Slot& { return slots[(start + i) & (shard_slots_ - 1)]; };
+
+        // 이미 있거나 빈 칸이 있으면 거기
+        Slot* target = nullptr;
+        for (size_t i = 0; i < PROBE && !target; ++i) {
+            auto stored = at(i).key.load(std::memory_order_relaxed);
+            if (stored == key) return;
+            if (stored == 0) target = &at(i);
+        }
+
+        // CLOCK: 바늘 위치부터 참조 비트를 지우며 최대 두 바퀴
+        if (!target) {
+            const size_t hand = shard.hand.fetch_add(1, std::memory_order_relaxed);
+            for (size_t i = 0; i < 2 * PROBE; ++i) {
+                auto& slot = at((hand + i) % PROBE);
+                if (slot.referenced.exchange(0, std::memory_order_relaxed) == 0) {
+                    target = &slot;
+                    break;
+                }
+            }
+            if (!target) target = &at(hand % PROBE);
+        }
+
+        auto sequence = target->sequence.load(std::memory_order_relaxed);
+        if ((sequence & 1) || !target->sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire)) {
+            return;     // 다른 스레드가 이 칸을 쓰는 중
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        const bool evicting = target->key.load(std::memory_order_relaxed) != 0;
+        target->key.store(key, std::memory_order_relaxed);
+        target->value.store(std::bit_cast<std::uint64_t>(value), std::memory_order_relaxed);
+        target->referenced.store(1, std::memory_order_relaxed);
+        target->sequence.store(sequence + 2, std::memory_order_release);
+
+        shard.insertions.fetch_add(1, std::memory_order_relaxed);
+        if (evicting) shard.evictions.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 있으면 캐시 값, 없으면 compute() 를 불러서 넣고 돌려준다
+    template<typename F>
+    double get(std::uint64_t key, F&& compute) {
+        if (auto cached = find(key)) return *cached;
+        double value = compute();
+        insert(key, value);
+        return value;
+    }
+
+    EquityCacheStats stats() const {
+        EquityCacheStats total;
+        for (size_t s = 0; s < shard_count_; ++s) {
+            total.hits += shards_[s].hits.load(std::memory_order_relaxed);
+            total.misses += shards_[s].misses.load(std::memory_order_relaxed);
+            total.insertions += shards_[s].insertions.load(std::memory_order_relaxed);
+            total.evictions += shards_[s].evictions.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    size_t capacity() const { return shard_count_ * shard_slots_; }
+
+private:
+    static constexpr std::uint64_t VALID = std::uint64_t{1} << 63;   // 0 = 빈 칸과 구분
+
+    struct alignas(32) Slot {
+        std::atomic<std::uint32_t> sequence{0};     // 홀수 = 쓰는 중
+        std::atomic<std::uint32_t> referenced{0};   // CLOCK 참조 비트
+        std::atomic<std::uint64_t> key{0};
+        std::atomic<std::uint64_t> value{0};        // double 비트
+    };
+
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> hits{0};
+        std::atomic<std::uint64_t> misses{0};
+        std::atomic<std::uint64_t> insertions{0};
+        std::atomic<std::uint64_t> evictions{0};
+        std::atomic<size_t> hand{0};                // CLOCK 바늘
+    };
+
+    struct ReadResult {
+        std::uint64_t key;
+        std::uint64_t value;
+        bool stable;
+    };
+
+    const size_t shard_count_;
+    const size_t shard_slots_;
+    const int shard_shift_;
+    std::unique_ptr<Slot[]> slots_;
+    std::unique_ptr<Shard[]> shards_;
+
+    // splitmix64 마무리 (위쪽 비트 = 샤드, 아래쪽 비트 = 샤드 안 위치)
+    static std::uint64_t hash(std::uint64_t x) {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    size_t shard_of(std::uint64_t h) const {
+        return shard_count_ == 1 ? 0 : static_cast<size_t>(h >> shard_shift_);
+    }
+
+    static ReadResult read(const Slot& slot) {
+        const auto before = slot.sequence.load(std::memory_order_acquire);
+        if (before & 1) return {0, 0, false};
+        auto key = slot.key.load(std::memory_order_relaxed);
+        auto value = slot.value.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return {key, value, slot.sequence.load(std::memory_order_relaxed) == before};
+    }
+};
+
+} // namespace poker
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "card_set.hpp"
+#include "hand.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace poker {
+
+/*
+비트 마스크 기반 평가기 (5~7장)
+
+Hand<5>::value() 와 완전히 같은 HandValue 를 돌려준다.
+6~7장이면 가능한 5장 조합 중 가장 높은 HandValue 를 고른다.
+Hand 처럼 정렬/임시 객체를 만들지 않으므로 에퀴티 계산처럼
+수백만 번 평가하는 곳에서 사용한다.
+*/
+namespace detail {
+
+    constexpr std::uint16_t WHEEL_MASK = 0b1'0000'0000'1111;      // A 5 4 3 2
+    constexpr std::uint16_t BROADWAY_MASK = 0b1'1111'0000'0000;   // A K Q J T
+
+    // 랭크 마스크에서 스트레이트 5장을 고른다 (없으면 0)
+    // Hand<5> 는 정렬된 카드 순서로 타이브레이커를 만들기 때문에
+    // 휠(A5432)이 A 하이로 비교된다. 순서: 브로드웨이 > 휠 > K 하이 > ... > 6 하이
+    constexpr std::uint16_t best_straight(std::uint16_t mask) {
+        if ((mask & BROADWAY_MASK) == BROADWAY_MASK) return BROADWAY_MASK;
+        if ((mask & WHEEL_MASK) == WHEEL_MASK) return WHEEL_MASK;
+        for (int top = 11; top >= 4; --top) {
+            std::uint16_t window = static_cast<std::uint16_t>(0x1F << (top - 4));
+            if ((mask & window) == window) return window;
+        }
+        return 0;
+    }
+
+    // 13비트 마스크별 best_straight 결과 (8192 * 2바이트)
+    inline constexpr auto STRAIGHT_TABLE = [] {
+        std::array<std::uint16_t, 8192> table{};
+        for (size_t m = 0; m < table.size(); ++m) {
+            table[m] = best_straight(static_cast<std::uint16_t>(m));
+        }
+        return table;
+    }();
+
+    constexpr int highest_rank(std::uint16_t mask) {
+        return 15 - std::countl_zero(mask);  // 16비트 기준 최상위 비트 위치
+    }
+
+    // 마스크의 높은 랭크부터 최대 count 개를 result[idx..] 에 채운다
+    constexpr void push_top_ranks(std::array<Rank, 5>& result, size_t& idx,
+                                  std::uint16_t mask, size_t count) {
+        for (; mask && count > 0 && idx < 5; --count) {
+            int r = highest_rank(mask);
+            result[idx++] = static_cast<Rank>(r + 2);
+            mask = static_cast<std::uint16_t>(mask & ~(1u << r));
+        }
+    }
+
+    // 수트별 랭크 마스크로 평가 (IncrementalHand 등에서 재사용)
+    // 랭크별 개수는 수트 마스크끼리의 AND/OR 로 한 번에 구한다.
+    constexpr HandValue evaluate_masks(const std::array<std::uint16_t, 4>& suits) {
+        HandValue v{};
+        size_t idx = 0;
+
+        // 플러시 / 스트레이트 플러시 (7장 이하에서는 플러시와 풀하우스/포카드가 공존할 수 없다)
+        for (auto suit_mask : suits) {
+            if (std::popcount(suit_mask) < 5) continue;
+            if (auto sf = STRAIGHT_TABLE[suit_mask]) {
+                v.rank = (sf & (1u << 12)) ? HandRank::RoyalFlush : HandRank::StraightFlush;
+                push_top_ranks(v.tiebreakers, idx, sf, 5);
+            } else {
+                v.rank = HandRank::Flush;
+                push_top_ranks(v.tiebreakers, idx, suit_mask, 5);
+            }
+            return v;
+        }
+
+        const auto [c, d, h, s] = suits;
+        const auto any = static_cast<std::uint16_t>(c | d | h | s);
+        const auto two_plus = static_cast<std::uint16_t>(
+            (c & d) | (c & h) | (c & s) | (d & h) | (d & s) | (h & s));
+        const auto three_plus = static_cast<std::uint16_t>(
+            (c & d & h) | (c & d & s) | (c & h & s) | (d & h & s));
+        const auto quads = static_cast<std::uint16_t>(c & d & h & s);
+        const auto trips = static_cast<std::uint16_t>(three_plus & ~quads);
+        const auto pairs = static_cast<std::uint16_t>(two_plus & ~three_plus);
+
+        if (quads) {
+            int q = highest_rank(quads);
+            v.rank = HandRank::FourOfKind;
+            v.tiebreakers[idx++] = static_cast<Rank>(q + 2);
+            push_top_ranks(v.tiebreakers, idx, static_cast<std::uint16_t>(any & ~(1u << q)), 1);
+            return v;
+        }
+
+        if (trips) {
+            int t = highest_rank(trips);
+            auto rest = static_cast<std::uint16_t>((trips | pairs) & ~(1u << t));
+            if (rest) {
+                v.rank = HandRank::FullHouse;
+                v.tiebreakers[idx++] = static_cast<Rank>(t + 2);
+                v.tiebreakers[idx++] = static_cast<Rank>(highest_rank(rest) + 2);
+                return v;
+            }
+        }
+
+        if (auto st = STRAIGHT_TABLE[any]) {
+            v.rank = HandRank::Straight;
+            push_top_ranks(v.tiebreakers, idx, st, 5);
+            return v;
+        }
+
+        if (trips) {
+            int t = highest_rank(trips);
+            v.rank = HandRank::ThreeOfKind;
+            v.tiebreakers[idx++] = static_cast<Rank>(t + 2);
+            push_top_ranks(v.tiebreakers, idx, static_cast<std::uint16_t>(any & ~(1u << t)), 2);
+            return v;
+        }
+
+        if (std::popcount(pairs) >= 2) {
+            int p1 = highest_rank(pairs);
+            int p2 = highest_rank(static_cast<std::uint16_t>(pairs & ~(1u << p1)));
+            v.rank = HandRank::TwoPair;
+            v.tiebreakers[idx++] = static_cast<Rank>(p1 + 2);
+            v.tiebreakers[idx++] = static_cast<Rank>(p2 + 2);
+            push_top_ranks(v.tiebreakers, idx,
+                static_cast<std::uint16_t>(any & ~(1u << p1) & ~(1u << p2)), 1);
+            return v;
+        }
+
+        if (pairs) {
+            int p = highest_rank(pairs);
+            v.rank = HandRank::OnePair;
+            v.tiebreakers[idx++] = static_cast<Rank>(p + 2);
+            push_top_ranks(v.tiebreakers, idx, static_cast<std::uint16_t>(any & ~(1u << p)), 3);
+            return v;
+        }
+
+        v.rank = HandRank::TopCard;
+        push_top_ranks(v.tiebreakers, idx, any, 5);
+        return v;
+    }
+
+} // namespace detail
+
+// 5~7장 카드 집합 평가
+constexpr HandValue evaluate(CardSet cards) {
+    std::array<std::uint16_t, 4> suits{
+        cards.suit_mask(Suit::Clubs),
+        cards.suit_mask(Suit::Diamonds),
+        cards.suit_mask(Suit::Hearts),
+        cards.suit_mask(Suit::Spades)
+    };
+    return detail::evaluate_masks(suits);
+}
+
+// 6~7장 중 evaluate() 값을 내는 5장 (5장 이하면 그대로)
+constexpr CardSet best_five(CardSet cards) {
+    if (cards.size() <= 5) return cards;
+    const auto target = evaluate(cards).packed();
+    const size_t drop = cards.size() - 5;
+    for (std::uint64_t a = cards.bits(); a; a &= a - 1) {
+        CardSet without_a{cards.bits() & ~(a & -a)};
+        if (drop == 1) {
+            if (evaluate(without_a).packed() == target) return without_a;
+            continue;
+        }
+        for (std::uint64_t b = a & (a - 1); b; b &= b - 1) {
+            CardSet five{without_a.bits() & ~(b & -b)};
+            if (evaluate(five).packed() == target) return five;
+        }
+    }
+    return cards;  // 7장 넘게 들어오는 경우는 없다
+}
+
+} // namespace poker
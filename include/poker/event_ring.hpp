@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+namespace poker {
+
+/*
+여러 테이블 스레드 → 소비 스레드 하나로 가는 고정 크기 이벤트 링 (MPSC, 락 없음)
+
+    MpscRing<HistoryEvent> ring(1 << 16);
+    ring.push(event);                                   // 테이블 스레드 (아무 스레드나)
+    ring.drain([&](const HistoryEvent& e) { ... });     // 소비 스레드 하나
+
+칸마다 순번(sequence) 을 두는 Vyukov 방식
+- 칸 i 의 순번 == 티켓 t 이면 비어 있고 t 가 쓸 차례, t + 1 이면 t 가 쓴 값이 들어 있다
+- push: tail 에 fetch_add 한 번으로 티켓을 받고, 값을 쓰고, 순번을 t + 1 로 (링이 안 찼으면 대기 없음)
+- try_push: 남은 자리를 보고 CAS 로 티켓을 받는다. 가득 차 있으면 아무것도 안 하고 false
+- drain: 순번이 맞는 칸을 연속으로 읽고 칸을 다음 바퀴(t + 용량) 에 넘긴다.
+  head 공개와 막힌 생산자 깨우기는 묶음마다 한 번
+tail(생산자들) 과 head(소비자) 는 서로 다른 캐시라인에 둔다.
+*/
+template<typename T>
+class MpscRing {
+    static_assert(std::is_trivially_copyable_v<T>, "MpscRing copies events as plain values");
+
+public:
+    explicit MpscRing(size_t capacity)
+        : capacity_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+          mask_(capacity_ - 1),
+          cells_(std::make_unique<Cell[]>(capacity_))
+    {
+        for (size_t i = 0; i < capacity_; ++i) cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpscRing(const MpscRing&) = delete;
+    MpscRing& operator=(const MpscRing&) = delete;
+
+    // 가득 차 있으면 소비자가 자리를 비울 때까지 기다린다
+    void push(const T& value) {
+        const auto ticket = tail_.fetch_add(1, std::memory_order_relaxed);
+        auto& cell = cells_[ticket & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) != ticket) wait_for_slot(cell, ticket);
+        cell.value = value;
+        cell.sequence.store(ticket + 1, std::memory_order_release);
+    }
+
+    // 가득 차 있으면 false (생산자는 절대 기다리지 않는다)
+    bool try_push(const T& value) {
+        auto ticket = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            auto& cell = cells_[ticket & mask_];
+            auto sequence = cell.sequence.load(std::memory_order_acquire);
+            if (sequence == ticket) {
+                if (tail_.compare_exchange_weak(ticket, ticket + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(ticket + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (sequence < ticket) {
+                return false;   // 한 바퀴 전 값을 소비자가 아직 안 읽었다
+            } else {
+                ticket = tail_.load(std::memory_order_relaxed);   // 다른 생산자가 먼저 가져갔다
+            }
+        }
+    }
+
+    // 소비 스레드 전용. 공개된 이벤트를 순서대로 최대 max_items 개 f(const T&) 로 넘긴다
+    template<typename F>
+    size_t drain(F&& f, size_t max_items = std::numeric_limits<size_t>::max()) {
+        auto head = head_.load(std::memory_order_relaxed);
+        const auto first = head;
+        for (; head - first < max_items; ++head) {
+            auto& cell = cells_[head & mask_];
+            if (cell.sequence.load(std::memory_order_acquire) != head + 1) break;
+            f(cell.value);
+            cell.sequence.store(head + capacity_, std::memory_order_release);
+        }
+        if (head == first) return 0;
+        head_.store(head, std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_seq_cst) > 0) head_.notify_all();
+        return static_cast<size_t>(head - first);
+    }
+
+    // 소비 스레드 전용 (생산자 쪽에서 보면 순간 값일 뿐)
+    bool empty() const {
+        auto head = head_.load(std::memory_order_relaxed);
+        return cells_[head & mask_].sequence.load(std::memory_order_acquire) != head + 1;
+    }
+
+    // 소비 스레드 전용. 티켓만 받고 아직 쓰는 중인 생산자까지 없어야 true
+    bool settled() const {
+        return tail_.load(std::memory_order_acquire) == head_.load(std::memory_order_relaxed);
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    struct Cell {
+        std::atomic<std::uint64_t> sequence{0};
+        T value{};
+    };
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<std::uint64_t> tail_{0};     // 생산자들이 fetch_add
+    alignas(64) std::atomic<std::uint64_t> head_{0};     // 소비자만 쓴다 (막힌 생산자는 여기서 잔다)
+    std::atomic<std::uint32_t> waiters_{0};              // 링이 가득 차서 기다리는 생산자 수
+
+    // 링이 가득 찬 경우만. 소비자가 head 를 공개할 때마다 깨서 내 칸이 비었는지 다시 본다
+    void wait_for_slot(Cell& cell, std::uint64_t ticket) {
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        while (true) {
+            auto head = head_.load(std::memory_order_seq_cst);
+            if (cell.sequence.load(std::memory_order_acquire) == ticket) break;
+            head_.wait(head, std::memory_order_seq_cst);
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+} // namespace poker
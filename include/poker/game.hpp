@@ -2,51 +2,243 @@
 #include "deck.hpp"
 #include "player.hpp"
 #include "action.hpp"
+#include "game_state.hpp"
+#include "stats.hpp"
+#include "hand_history.hpp"
+#include "trace.hpp"
+#include "variant.hpp"
 #include <vector>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ctime>
 #include <functional>
 #include <iostream>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
 
 namespace poker {
 
-class Game {
+/*
+게임 진행 (변형 정책 V 로 컴파일 타임 특수화)
+
+    Game game;                      // = BasicGame<FiveCardDraw>
+    BasicGame<Holdem> holdem;       // Player<2>, 플랍/턴/리버
+    BasicGame<SevenCardStud> stud;  // Player<7>, 7장 중 가장 좋은 5장
+
+딜 순서/스트리트 수/쇼다운 카드 수는 V 에서, 베팅과 정산은 BasicGameState<V> 에서 온다.
+전략은 5카드 드로우면 Hand<5> 를, 나머지 변형은 지금 보이는 카드(CardSet) 를 받는다.
+*/
+template<GameVariant V>
+class BasicGame {
 public:
-    using DecisionCallback = std::function<Decision(const Hand<5>&, size_t pot, size_t to_call)>;
+    using Variant = V;
+    using Traits = VariantTraits<V>;
+    using State = BasicGameState<V>;
+    using PlayerType = Player<Traits::HOLE_CARDS>;
+    // 전략이 받는 카드: 드로우는 Hand<5> 그대로, 스트리트가 있는 변형은 보이는 카드 집합
+    using View = std::conditional_t<Traits::DECIDES_ON_HAND, const Hand<5>&, CardSet>;
+    using DecisionCallback = std::function<Decision(View, size_t pot, size_t to_call)>;
+    
+    // 이번 핸드의 공개 액션 하나 (결정 직전의 팟/콜 금액과 함께)
+    struct ActionRecord {
+        std::uint8_t seat{0};
+        Action action{Action::Fold};
+        std::uint32_t pot{0};
+        std::uint32_t to_call{0};
+    };
     
+    // 베팅/카드 상태는 GameState 에, 여기는 테이블 밖과 연결되는 것만
     struct Seat {
-        Player<5>* player;
+        PlayerType* player;
         DecisionCallback decide;
-        bool folded{false};
-        size_t round_bet{0};
+        PlayerStats* stats{nullptr};
+        bool voluntary{false};  // 이번 핸드에 자발적으로 칩을 넣었는지 (VPIP)
+        std::uint16_t history_id{0};
     };
 
-    explicit Game(size_t small_blind = 10) 
-        : small_blind_(small_blind) 
-    {}
+    // log 가 nullptr 이면 출력하지 않는다 (시뮬레이션용)
+    explicit BasicGame(size_t small_blind = 10, std::ostream* log = &std::cout) 
+        : log_(log) 
+    {
+        state_.small_blind = chip_count(small_blind);
+    }
+
+    // 좌석 콜백과 attach 한 전략(SmartAI, MctsAI) 이 이 Game 의 주소를 들고 있다
+    BasicGame(const BasicGame&) = delete;
+    BasicGame& operator=(const BasicGame&) = delete;
     
     // 플레이어 추가 (AI 또는 사람)
     template<typename Strategy>
-    void add_player(Player<5>* player, Strategy& strategy) {
+    void add_player(PlayerType* player, Strategy& strategy) {
+        if (seats_.size() == Traits::MAX_PLAYERS) {
+            throw std::out_of_range("Table is full");
+        }
         seats_.push_back(Seat{
             player,
-            [&strategy](const Hand<5>& h, size_t p, size_t c) {
-                return strategy.decide(h, p, c);
+            [&strategy](View view, size_t p, size_t c) {
+                return strategy.decide(view, p, c);
             },
+            stats_ ? &stats_->player(player->name()) : nullptr,
             false,
-            0
+            history_ ? history_->register_player(player->name()) : std::uint16_t{0}
         });
+        state_.seat_count = static_cast<std::uint8_t>(seats_.size());
+        
+        // 테이블 상태를 직접 읽는 전략(MctsAI 등)에게 Game 을 알려준다
+        if constexpr (requires { strategy.attach(*this); }) {
+            strategy.attach(*this);
+        }
+    }
+    
+    // 핸드 사이에만. 딜러 버튼은 같은 사람(빠진 사람이면 다음 사람)에게 남는다
+    void remove_player(const PlayerType* player) {
+        if (!state_.finished) throw std::logic_error("Cannot remove a player during a hand");
+        auto it = std::find_if(seats_.begin(), seats_.end(),
+                               [&](const Seat& seat) { return seat.player == player; });
+        if (it == seats_.end()) throw std::invalid_argument("Player is not seated at this table");
+        
+        auto removed = static_cast<size_t>(it - seats_.begin());
+        seats_.erase(it);
+        for (size_t i = removed; i < seats_.size(); ++i) state_.seats[i] = state_.seats[i + 1];
+        state_.seats[seats_.size()] = typename State::Seat{};
+        state_.seat_count = static_cast<std::uint8_t>(seats_.size());
+        
+        if (state_.dealer > removed) --state_.dealer;
+        if (state_.dealer >= seats_.size()) state_.dealer = 0;
+    }
+    
+    // 다음 핸드부터 적용 (토너먼트 블라인드 레벨)
+    void set_small_blind(size_t small_blind) {
+        state_.small_blind = chip_count(small_blind);
+    }
+    
+    // 액션 기록을 통계 트래커로 보낸다 (이미 앉은 플레이어도 등록)
+    void attach_stats(StatsTracker& tracker) {
+        stats_ = &tracker;
+        for (auto& seat : seats_) {
+            seat.stats = &tracker.player(seat.player->name());
+        }
+    }
+    
+    // 핸드 히스토리를 비동기 기록기로 보낸다 (테이블 스레드는 이벤트만 넘긴다)
+    void attach_history(HandHistoryExporter& exporter, std::uint32_t table_id) {
+        history_ = &exporter;
+        table_id_ = table_id;
+        game_history_id_ = exporter.register_game(V::NAME);
+        for (auto& seat : seats_) {
+            seat.history_id = exporter.register_player(seat.player->name());
+        }
+    }
+    
+    // 덱 셔플 시드 고정 (같은 시드 → 같은 딜)
+    void seed(std::uint32_t value) {
+        deck_.seed(value);
     }
     
     // 라운드 시작
     void start_round() {
-        // 리셋
         deck_.reset();
         deck_.shuffle();
-        pot_ = 0;
-        current_bet_ = 0;
+        play_round();
+    }
+    
+    // 미리 섞어 둔 덱으로 라운드 시작 (DeckBatch 로 여러 테이블 덱을 한 번에 만들 때)
+    void start_round(std::span<const PackedCard> order) {
+        if (order.size() != 52) throw std::invalid_argument("Deck order must have 52 cards");
+        std::array<Card, 52> cards;
+        CardSet seen;
+        for (size_t i = 0; i < cards.size(); ++i) {
+            cards[i] = order[i].card();
+            seen.insert_index(order[i].index);
+        }
+        if (seen.size() != cards.size()) throw std::invalid_argument("Deck order has duplicate cards");
+        deck_.load(cards);
+        play_round();
+    }
+    
+    // 현재 상태를 값으로 복사 (탐색 AI 가 분기해서 GameState::apply 로 굴린다)
+    State snapshot() const {
+        State state = state_;
+        for (size_t i = 0; i < seats_.size(); ++i) {
+            state.seats[i].chips = chip_count(seats_[i].player->chips());
+        }
+        return state;
+    }
+    
+    // 스냅샷으로 되돌린다 (플레이어 칩/핸드 포함). 진행 중이던 핸드는 resume() 으로 마저
+    void restore(const State& state) {
+        if (state.seat_count != seats_.size()) {
+            throw std::invalid_argument("GameState seat count does not match the table");
+        }
+        state_ = state;
+        actions_.clear();  // 스냅샷에는 액션 기록이 없다
+        sync_chips();
+        for (size_t i = 0; i < seats_.size(); ++i) {
+            auto& player = *seats_[i].player;
+            if (state_.seats[i].live && state_.street >= Traits::HAND_COMPLETE_STREET) {
+                player.receive_hand(state_.hand(i));
+            } else {
+                player.fold();
+            }
+        }
+    }
+    
+    void resume() {
+        if (state_.finished) return;
+        betting_round();
+        showdown();
+    }
+    
+    // 이번 핸드에서 지금까지 나온 액션 (탐색 AI 가 상대 핸드를 추론할 때 쓴다)
+    const std::vector<ActionRecord>& actions() const { return actions_; }
+    
+    size_t pot() const { return state_.pot; }
+    size_t small_blind() const { return state_.small_blind; }
+    size_t player_count() const { return seats_.size(); }
+    size_t active_players() const { return state_.active; }   // 이번 핸드에서 폴드하지 않은 좌석
+
+private:
+    std::vector<Seat> seats_;
+    Deck deck_;
+    State state_;
+    std::vector<ActionRecord> actions_;
+    StatsTracker* stats_{nullptr};
+    HandHistoryExporter* history_{nullptr};
+    std::uint32_t table_id_{0};
+    std::uint16_t game_history_id_{0};
+    std::uint64_t hand_count_{0};
+    std::ostream* log_;
+    
+    // Fold Expression 으로 인자를 전부 출력 (log_ 가 없으면 무시)
+    template<typename... Args>
+    void log(const Args&... args) {
+        if (log_) ((*log_ << args), ...);
+    }
+    
+    // 블라인드부터 쇼다운까지 (덱은 이미 섞여 있다)
+    void play_round() {
+        TraceSpan span("start_round", "game");
         
-        for (auto& seat : seats_) {
-            seat.folded = false;
-            seat.round_bet = 0;
+        // 리셋 (핸드 사이에 바뀐 플레이어 칩도 반영)
+        for (size_t i = 0; i < seats_.size(); ++i) {
+            state_.seats[i].chips = chip_count(seats_[i].player->chips());
+        }
+        state_.reset(deck_.cards());
+        actions_.clear();
+        ++hand_count_;
+        
+        record(HistoryEventType::HandStart, nullptr,
+               static_cast<size_t>(std::time(nullptr)), 0, state_.dealer);
+        
+        // 칩이 없는 좌석은 이번 핸드에 없다
+        for (size_t i = 0; i < seats_.size(); ++i) {
+            auto& seat = seats_[i];
+            seat.voluntary = false;
+            if (!state_.seats[i].live) continue;
+            if (seat.stats) seat.stats->on_hand_start();
+            record(HistoryEventType::Seat, &seat, seat.player->chips());
         }
         
         // 블라인드
@@ -62,151 +254,221 @@ public:
         showdown();
     }
     
-    size_t pot() const { return pot_; }
-    size_t player_count() const { return seats_.size(); }
-
-private:
-    std::vector<Seat> seats_;
-    Deck deck_;
-    size_t pot_{0};
-    size_t current_bet_{0};
-    size_t small_blind_;
-    size_t dealer_pos_{0};
+    // GameState 는 칩을 32비트로 들고 있다
+    static std::uint32_t chip_count(size_t chips) {
+        if (chips > UINT32_MAX) throw std::out_of_range("Chip count does not fit GameState");
+        return static_cast<std::uint32_t>(chips);
+    }
+    
+    // 핸드 중에는 GameState 가 기준. 플레이어 칩을 맞춘다
+    void sync_chips() {
+        for (size_t i = 0; i < seats_.size(); ++i) {
+            auto& player = *seats_[i].player;
+            size_t chips = state_.seats[i].chips;
+            if (chips < player.chips()) player.bet(player.chips() - chips);
+            else player.add_chips(chips - player.chips());
+        }
+    }
+    
+    // 히스토리 이벤트 하나 (기록기가 없으면 아무것도 안 한다)
+    void record(HistoryEventType type, const Seat* seat, size_t amount = 0, size_t total = 0,
+                std::uint8_t detail = 0, CardSet cards = {}) {
+        if (!history_) return;
+        HistoryEvent event;
+        event.hand_id = (std::uint64_t{table_id_} << 32) | hand_count_;
+        event.table_id = table_id_;
+        event.type = type;
+        event.amount = static_cast<std::uint32_t>(amount);
+        event.total = static_cast<std::uint32_t>(total);
+        event.detail = detail;
+        if (seat) {
+            event.player = seat->history_id;
+            event.seat = static_cast<std::uint8_t>(seat - seats_.data());
+        } else if (type == HistoryEventType::HandStart) {
+            event.player = game_history_id_;
+        } else if (type == HistoryEventType::Deal) {
+            event.seat = HistoryEvent::BOARD;
+        }
+        cards.for_each([&](const Card& card) {
+            event.cards[event.card_count++] = PackedCard{card};
+        });
+        history_->publish(event);
+    }
     
     void post_blinds() {
-        size_t sb_pos = (dealer_pos_ + 1) % seats_.size();
-        size_t bb_pos = (dealer_pos_ + 2) % seats_.size();
-        
-        // 스몰 블라인드
-        size_t sb = small_blind_;
-        seats_[sb_pos].player->bet(sb);
-        seats_[sb_pos].round_bet = sb;
-        pot_ += sb;
+        TraceSpan span("post_blinds", "game");
+        auto [sb, bb] = state_.post_blinds();
+        sync_chips();
         
-        // 빅 블라인드
-        size_t bb = small_blind_ * 2;
-        seats_[bb_pos].player->bet(bb);
-        seats_[bb_pos].round_bet = bb;
-        pot_ += bb;
-        current_bet_ = bb;
+        record(HistoryEventType::Blind, &seats_[state_.small_blind_seat], sb, 0, 0);
+        record(HistoryEventType::Blind, &seats_[state_.big_blind_seat], bb, 0, 1);
         
-        std::cout << "Blinds posted: SB=" << sb << ", BB=" << bb << "\n";
+        log("Blinds posted: SB=", sb, ", BB=", bb, "\n");
     }
     
     void deal_cards() {
-        for (auto& seat : seats_) {
-            seat.player->receive_hand(deck_.deal<5>());
+        TraceSpan span("deal_cards", "game");
+        state_.deal();
+        sync_chips();  // 모두 올인이면 바로 쇼다운까지 끝난다
+        size_t dealt = 0;
+        for (size_t i = 0; i < seats_.size(); ++i) {
+            if (!state_.seats[i].live) {
+                seats_[i].player->fold();  // 칩이 없어서 빠진 좌석 (아직 아무도 폴드하지 않았다)
+                continue;
+            }
+            ++dealt;
+            if constexpr (Traits::HAND_COMPLETE_STREET == 0) seats_[i].player->receive_hand(state_.hand(i));
+            record(HistoryEventType::Deal, &seats_[i], 0, 0, street_marker(0), state_.hand_cards(i));
+        }
+        record_board(0);
+        log("Cards dealt to ", dealt, " players\n");
+        if constexpr (Traits::STREET_COUNT > 1) on_new_streets(0);
+    }
+    
+    // GameState::apply 가 from 이후 스트리트를 나눠줬으면 플레이어/기록에 반영
+    void on_new_streets(size_t from) {
+        for (size_t street = from + 1; street <= state_.street; ++street) {
+            const size_t first = Traits::HOLE_BEFORE[street];
+            const size_t last = Traits::HOLE_BEFORE[street + 1];
+            for (size_t i = 0; i < seats_.size(); ++i) {
+                if (!state_.seats[i].live) continue;
+                if (street == Traits::HAND_COMPLETE_STREET) seats_[i].player->receive_hand(state_.hand(i));
+                CardSet dealt;
+                for (size_t k = first; k < last; ++k) dealt.insert_index(state_.seats[i].hand[k].index);
+                if (!dealt.empty()) record(HistoryEventType::Deal, &seats_[i], 0, 0, street_marker(street), dealt);
+            }
+            record_board(street);
+            log("Street ", street + 1, " dealt\n");
+        }
+    }
+    
+    // street 에 깐 공용 카드 (플랍/턴/리버)
+    void record_board(size_t street) {
+        if constexpr (Traits::BOARD_CARDS > 0) {
+            CardSet board;
+            for (size_t k = Traits::BOARD_BEFORE[street]; k < Traits::BOARD_BEFORE[street + 1]; ++k) {
+                board.insert_index(state_.board[k].index);
+            }
+            if (!board.empty()) record(HistoryEventType::Deal, nullptr, 0, 0, street_marker(street), board);
+        } else {
+            (void)street;
+        }
+    }
+    
+    // 히스토리의 스트리트 표시: 드로우는 DEALING HANDS, 공용 카드 게임은 HOLE CARDS / 공용 카드 수로 FLOP·TURN·RIVER,
+    // 스터드는 그때까지 받은 카드 수로 "3rd STREET" (7장째는 RIVER)
+    static constexpr std::uint8_t street_marker(size_t street) {
+        HistoryStreet marker = HistoryStreet::DealingHands;
+        if constexpr (Traits::BOARD_CARDS > 0) {
+            const size_t board = Traits::BOARD_BEFORE[street + 1];
+            marker = board < 3 ? HistoryStreet::HoleCards
+                   : board == 3 ? HistoryStreet::Flop
+                   : board == 4 ? HistoryStreet::Turn : HistoryStreet::River;
+        } else if constexpr (Traits::STREET_COUNT > 1) {
+            const size_t cards = Traits::HOLE_BEFORE[street + 1];
+            marker = cards == 7 ? HistoryStreet::River
+                   : static_cast<HistoryStreet>(static_cast<size_t>(HistoryStreet::Stud) + cards);
+        } else {
+            (void)street;
         }
-        std::cout << "Cards dealt to " << seats_.size() << " players\n";
+        return static_cast<std::uint8_t>(marker);
     }
     
     void betting_round() {
-        size_t start_pos = (dealer_pos_ + 3) % seats_.size();
-        size_t actions_without_raise = 0;
-        size_t active_players = seats_.size();
-        
-        size_t pos = start_pos;
+        TraceSpan span("betting_round", "game");
         
-        while (actions_without_raise < active_players) {
-            auto& seat = seats_[pos];
+        while (!state_.finished) {
+            auto& seat = seats_[state_.to_act];
+            size_t to_call = state_.to_call();
+            size_t bet_before = state_.current_bet;
+            size_t round_before = state_.seats[state_.to_act].round_bet;
+            size_t street = state_.street;
             
-            if (!seat.folded && seat.player->has_hand()) {
-                size_t to_call = current_bet_ - seat.round_bet;
-                
-                Decision decision = seat.decide(
-                    seat.player->hand(), 
-                    pot_, 
-                    to_call
-                );
-                
-                process_decision(seat, decision, to_call);
-                
-                if (decision.action == Action::Raise || decision.action == Action::Bet) {
-                    actions_without_raise = 1;
+            Decision decision = [&] {
+                TraceSpan decide_span("decide", "strategy");
+                if constexpr (Traits::DECIDES_ON_HAND) {
+                    return seat.decide(seat.player->hand(), state_.pot, to_call);
                 } else {
-                    actions_without_raise++;
-                }
-                
-                if (decision.action == Action::Fold) {
-                    active_players--;
+                    return seat.decide(state_.visible(state_.to_act), state_.pot, to_call);
                 }
+            }();
+            
+            if (seat.stats) {
+                // 첫 스트리트는 빅 블라인드, 이후 스트리트는 0 보다 높은 베팅이 레이즈
+                size_t opening_bet = street == 0 ? state_.small_blind * 2u : 0u;
+                bool facing_raise = bet_before > opening_bet && to_call > 0;
+                bool puts_chips = (decision.action == Action::Call && to_call > 0) ||
+                                  decision.action == Action::Bet ||
+                                  decision.action == Action::Raise ||
+                                  decision.action == Action::AllIn;
+                seat.stats->on_action(decision.action, facing_raise, puts_chips && !seat.voluntary);
+                seat.voluntary = seat.voluntary || puts_chips;
             }
             
-            pos = (pos + 1) % seats_.size();
+            actions_.push_back(ActionRecord{state_.to_act, decision.action, state_.pot,
+                                            static_cast<std::uint32_t>(to_call)});
+            size_t paid = state_.apply(decision);
+            sync_chips();
+            if (decision.action == Action::Fold) seat.player->fold();
+            // 스트리트가 끝나면 GameState 의 베팅액이 비워지므로 액션 전 값으로 계산
+            size_t bet_after = std::max(bet_before, round_before + paid);
+            log_decision(decision, paid, bet_after);
             
-            // 한 명만 남으면 종료
-            if (active_players <= 1) break;
+            // 레이즈는 올린 폭과 최종 베팅액, 나머지는 실제로 낸 칩
+            record(HistoryEventType::Action, &seat,
+                   is_raise(decision.action) ? bet_after - bet_before : paid,
+                   bet_after, static_cast<std::uint8_t>(decision.action));
+            if constexpr (Traits::STREET_COUNT > 1) {
+                if (state_.street != street) on_new_streets(street);
+            }
         }
     }
     
-    void process_decision(Seat& seat, const Decision& decision, size_t to_call) {
+    static bool is_raise(Action action) {
+        return action == Action::Bet || action == Action::Raise;
+    }
+    
+    void log_decision(const Decision& decision, size_t paid, size_t bet_after) {
         switch (decision.action) {
-            case Action::Fold:
-                seat.folded = true;
-                seat.player->fold();
-                std::cout << "Player folds\n";
-                break;
-                
-            case Action::Check:
-                std::cout << "Player checks\n";
-                break;
-                
-            case Action::Call:
-                seat.player->bet(to_call);
-                seat.round_bet += to_call;
-                pot_ += to_call;
-                std::cout << "Player calls " << to_call << "\n";
-                break;
-                
+            case Action::Fold:  log("Player folds\n"); break;
+            case Action::Check: log("Player checks\n"); break;
+            case Action::Call:  log("Player calls ", paid, "\n"); break;
             case Action::Bet:
-            case Action::Raise: {
-                size_t total = to_call + decision.amount;
-                seat.player->bet(total);
-                seat.round_bet += total;
-                pot_ += total;
-                current_bet_ = seat.round_bet;
-                std::cout << "Player raises to " << current_bet_ << "\n";
-                break;
-            }
-                
-            case Action::AllIn: {
-                size_t all = seat.player->chips();
-                seat.player->bet(all);
-                seat.round_bet += all;
-                pot_ += all;
-                if (seat.round_bet > current_bet_) {
-                    current_bet_ = seat.round_bet;
-                }
-                std::cout << "Player goes all-in: " << all << "\n";
-                break;
-            }
+            case Action::Raise: log("Player raises to ", bet_after, "\n"); break;
+            case Action::AllIn: log("Player goes all-in: ", paid, "\n"); break;
         }
     }
     
+    // 정산은 GameState 가 끝냈다. 여기서는 결과를 기록만 한다
     void showdown() {
-        std::cout << "\n=== Showdown ===\n";
-        std::cout << "Pot: " << pot_ << "\n";
+        TraceSpan span("showdown", "game");
+        log("\n=== Showdown ===\n");
+        log("Pot: ", state_.pot, "\n");
         
-        Seat* winner = nullptr;
+        if (state_.uncalled) record(HistoryEventType::Uncalled, &seats_[state_.uncalled_seat], state_.uncalled);
         
-        for (auto& seat : seats_) {
-            if (!seat.folded && seat.player->has_hand()) {
-                std::cout << "Player hand: " << static_cast<int>(seat.player->hand().evaluate()) << "\n";
-                
-                if (!winner || seat.player->hand() > winner->player->hand()) {
-                    winner = &seat;
-                }
-            }
+        // 혼자 남았으면 카드를 보여주지 않고 팟만 가져간다 (쇼다운 없음)
+        for (size_t i = 0; i < seats_.size() && state_.contested(); ++i) {
+            if (!state_.seats[i].live) continue;
+            auto& seat = seats_[i];
+            CardSet shown = best_five(state_.visible(i));
+            HandRank rank;
+            if constexpr (Traits::DECIDES_ON_HAND) rank = seat.player->hand().evaluate();
+            else rank = evaluate(shown).rank;
+            log("Player hand: ", static_cast<int>(rank), "\n");
+            if (seat.stats) seat.stats->on_showdown(rank);
+            record(HistoryEventType::Show, &seat, 0, 0, static_cast<std::uint8_t>(rank), shown);
         }
         
-        if (winner) {
-            std::cout << "Winner takes pot: " << pot_ << "\n";
-            // 칩 지급은 Player에 add_chips 메서드 필요
+        // 팟마다 나눠 가진 합계 (동점이면 나머지 칩은 앞 좌석 승자에게)
+        for (size_t i = 0; i < seats_.size(); ++i) {
+            if (state_.winner(i)) record(HistoryEventType::Collect, &seats_[i], state_.winnings(i));
         }
-        
-        // 딜러 버튼 이동
-        dealer_pos_ = (dealer_pos_ + 1) % seats_.size();
+        if (state_.winners) log("Winner takes pot: ", state_.pot, "\n");
+        record(HistoryEventType::HandEnd, nullptr, state_.pot);
     }
 };
 
+using Game = BasicGame<FiveCardDraw>;
+
 } // namespace poker
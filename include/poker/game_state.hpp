@@ -0,0 +1,388 @@
+#pragma once
+
+#include "action.hpp"
+#include "card_set.hpp"
+#include "evaluator.hpp"
+#include "hand.hpp"
+#include "packed.hpp"
+#include "variant.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace poker {
+
+template<size_t HoleCards>
+struct BasicSeatState {
+    std::uint32_t chips{0};
+    std::uint32_t round_bet{0};     // 이번 스트리트에 낸 칩
+    std::uint32_t total_bet{0};     // 이번 핸드에 낸 칩 (사이드 팟 기준)
+    std::uint32_t won{0};           // 쇼다운에서 가져간 칩
+    std::array<PackedCard, HoleCards> hand{};
+    bool live{false};   // 카드를 받았고 아직 폴드하지 않음
+};
+
+using SeatState = BasicSeatState<5>;
+
+/*
+한 테이블의 핸드 진행 상태 (값 타입)
+
+덱 순서, 좌석, 팟, 베팅, 차례까지 전부 고정 크기 배열이라 trivially copyable 이다.
+탐색 AI 는 복사(memcpy 수백 바이트, 할당 없음)로 분기해서 apply() 로 진행한다.
+
+    GameState fork = state;
+    while (!fork.finished) fork.apply(policy(fork));
+    fork.seats[me].chips;   // 롤아웃 결과
+
+규칙은 Game 과 같다 (Game 이 내부적으로 이 상태를 그대로 쓴다):
+- 핸드 시작에 칩이 있는 좌석만 참여한다 (칩이 0인 좌석은 카드도, 블라인드도, 팟도 없다)
+- 딜러 다음 참여 좌석이 스몰, 그 다음이 빅 블라인드, 첫 스트리트는 빅 다음, 이후 스트리트는 딜러 +1 부터 액션
+- 베팅액이 올라가면 한 바퀴를 다시 돈다. 올인한 좌석은 건너뛴다
+- 모두 액션하면 다음 스트리트 카드를 나눠주고 베팅을 새로 시작한다 (V::STREETS 순서)
+- 한 명만 남거나 마지막 스트리트가 끝나면 쇼다운
+  - 아무도 맞추지 못한 베팅은 낸 사람에게 돌려준다 (uncalled)
+  - 올인 금액마다 사이드 팟을 나누고, 팟마다 그 금액을 다 낸 좌석끼리 겨룬다
+  - 동점은 나누고 나머지 칩은 앞 좌석 승자에게
+
+스트리트가 하나뿐인 변형(FiveCardDraw)은 스트리트 처리 코드가 if constexpr 로 빠진다.
+*/
+template<GameVariant V>
+struct BasicGameState {
+    using Traits = VariantTraits<V>;
+    using Seat = BasicSeatState<Traits::HOLE_CARDS>;
+    static constexpr size_t MAX_SEATS = 10;
+
+    std::array<PackedCard, 52> deck{};
+    std::array<Seat, MAX_SEATS> seats{};
+    std::array<PackedCard, Traits::BOARD_CARDS> board{};
+    std::uint32_t pot{0};
+    std::uint32_t current_bet{0};
+    std::uint32_t small_blind{10};
+    std::uint32_t uncalled{0};      // 쇼다운 전에 돌려준 칩 (uncalled_seat 에게)
+    std::uint16_t winners{0};       // 팟을 하나라도 가져간 좌석 비트마스크
+    std::uint8_t seat_count{0};
+    std::uint8_t top{0};            // 다음에 나눠줄 덱 위치
+    std::uint8_t dealer{0};
+    std::uint8_t to_act{0};
+    std::uint8_t actions_without_raise{0};
+    std::uint8_t active{0};         // 폴드하지 않은 좌석 수
+    std::uint8_t street{0};
+    std::uint8_t small_blind_seat{0};
+    std::uint8_t big_blind_seat{0};
+    std::uint8_t uncalled_seat{0};
+    bool finished{true};
+
+    // 새 핸드: 덱 순서를 받고 베팅/카드를 비운다 (칩과 딜러는 유지)
+    // 칩이 있는 좌석만 live 가 되고 이번 핸드에 참여한다
+    // 버튼이 칩 없는 좌석에 있으면 (핸드 사이에 칩을 바꾸거나 좌석을 뺀 경우) 다음 칩 있는 좌석으로 옮긴다
+    void reset(const std::array<Card, 52>& order) {
+        size_t funded = 0;
+        for (size_t s = 0; s < seat_count; ++s) funded += seats[s].chips > 0;
+        if (funded < 2) throw std::invalid_argument("GameState needs at least two seats with chips");
+        if (dealer >= seat_count) dealer = 0;
+        if (seats[dealer].chips == 0) dealer = static_cast<std::uint8_t>(next_funded(dealer));
+        for (size_t i = 0; i < deck.size(); ++i) deck[i] = PackedCard{order[i]};
+        for (size_t s = 0; s < seats.size(); ++s) {
+            auto& seat = seats[s];
+            seat.round_bet = 0;
+            seat.total_bet = 0;
+            seat.won = 0;
+            seat.live = s < seat_count && seat.chips > 0;
+        }
+        active = static_cast<std::uint8_t>(funded);
+        pot = 0;
+        current_bet = 0;
+        uncalled = 0;
+        winners = 0;
+        top = 0;
+        street = 0;
+        finished = false;
+    }
+
+    // (스몰, 빅) 실제로 낸 금액. 좌석은 small_blind_seat / big_blind_seat
+    std::pair<std::uint32_t, std::uint32_t> post_blinds() {
+        small_blind_seat = static_cast<std::uint8_t>(next_live(dealer));
+        big_blind_seat = static_cast<std::uint8_t>(next_live(small_blind_seat));
+        auto sb = put_chips(small_blind_seat, small_blind);
+        auto bb = put_chips(big_blind_seat, small_blind * 2);
+        current_bet = small_blind * 2;
+        return {sb, bb};
+    }
+
+    // 첫 스트리트 카드 (덱이 핸드 끝까지 모자라지 않는지도 여기서 확인)
+    void deal() {
+        if (top + seat_count * Traits::HOLE_CARDS + Traits::BOARD_CARDS > deck.size()) {
+            throw std::out_of_range("Not enough cards in deck");
+        }
+        deal_street();
+        actions_without_raise = 0;
+        to_act = static_cast<std::uint8_t>(seat_after(big_blind_seat, 1));
+        advance();
+    }
+
+    std::uint32_t to_call() const {
+        return current_bet - seats[to_act].round_bet;
+    }
+
+    // to_act 좌석의 결정을 적용하고 다음 차례로. 낸 칩을 돌려준다
+    // 베팅이 끝나면 쇼다운까지 처리하고 finished = true
+    std::uint32_t apply(const Decision& decision) {
+        if (finished) throw std::logic_error("Hand is already finished");
+
+        auto& seat = seats[to_act];
+        std::uint32_t owed = to_call();
+        std::uint32_t bet_before = current_bet;
+        std::uint32_t paid = 0;
+
+        switch (decision.action) {
+            case Action::Fold:
+                seat.live = false;
+                --active;
+                break;
+            case Action::Check:
+                break;
+            case Action::Call:
+                paid = put_chips(to_act, owed);
+                break;
+            case Action::Bet:
+            case Action::Raise:
+                paid = put_chips(to_act, owed + static_cast<std::uint32_t>(
+                    std::min<size_t>(decision.amount, UINT32_MAX - owed)));
+                current_bet = std::max(current_bet, seat.round_bet);
+                break;
+            case Action::AllIn:
+                paid = put_chips(to_act, seat.chips);
+                current_bet = std::max(current_bet, seat.round_bet);
+                break;
+        }
+
+        // 실제로 베팅액이 올라갔을 때만 한 바퀴를 다시 돈다.
+        // 폴드한 좌석은 active 에서 빠지므로 액션으로 세지 않는다 (세면 레이즈를 받은 좌석이 답하기 전에 끝난다)
+        if (current_bet > bet_before) actions_without_raise = 1;
+        else if (decision.action != Action::Fold) ++actions_without_raise;
+        to_act = static_cast<std::uint8_t>(seat_after(to_act, 1));
+        if (active <= 1) {
+            showdown();
+        } else {
+            advance();
+        }
+        return paid;
+    }
+
+    // 지금까지 받은 좌석 카드
+    CardSet hand_cards(size_t seat) const {
+        CardSet cards;
+        for (size_t i = 0; i < Traits::HOLE_BEFORE[street + 1]; ++i) cards.insert_index(seats[seat].hand[i].index);
+        return cards;
+    }
+
+    // 좌석 카드 전부 (마지막 좌석 카드를 받은 뒤에만)
+    Hand<Traits::HOLE_CARDS> hand(size_t seat) const {
+        return make_hand<Traits::HOLE_CARDS>(hand_cards(seat));
+    }
+
+    CardSet board_cards() const {
+        CardSet cards;
+        for (size_t i = 0; i < Traits::BOARD_BEFORE[street + 1]; ++i) cards.insert_index(board[i].index);
+        return cards;
+    }
+
+    // 이 좌석이 볼 수 있는 자기 카드 + 공용 카드 (쇼다운이면 평가할 카드 전부)
+    CardSet visible(size_t seat) const {
+        if constexpr (Traits::BOARD_CARDS == 0) return hand_cards(seat);
+        else return hand_cards(seat) | board_cards();
+    }
+
+    // 다른 좌석도 볼 수 있는 공개(up) 카드 (스터드)
+    CardSet exposed(size_t seat) const {
+        CardSet cards;
+        for (size_t i = 0; i < Traits::HOLE_BEFORE[street + 1]; ++i) {
+            if ((Traits::UP_MASK >> i) & 1) cards.insert_index(seats[seat].hand[i].index);
+        }
+        return cards;
+    }
+
+    bool winner(size_t seat) const { return (winners >> seat) & 1; }
+
+    // 쇼다운에서 가져간 칩 (사이드 팟 포함, 돌려받은 uncalled 는 빼고)
+    std::uint32_t winnings(size_t seat) const { return seats[seat].won; }
+
+    // 쇼다운까지 간 (평가한) 좌석이 둘 이상인가
+    bool contested() const { return active >= 2; }
+
+private:
+    size_t seat_after(size_t seat, size_t offset) const {
+        return (seat + offset) % seat_count;
+    }
+
+    // seat 다음의 이번 핸드 참여 좌석
+    size_t next_live(size_t seat) const {
+        do seat = seat_after(seat, 1); while (!seats[seat].live);
+        return seat;
+    }
+
+    // seat 다음의 칩이 있는 좌석 (다음 핸드 버튼). 칩이 있는 좌석이 하나 이상 있어야 한다
+    size_t next_funded(size_t seat) const {
+        do seat = seat_after(seat, 1); while (seats[seat].chips == 0);
+        return seat;
+    }
+
+    // 가진 칩보다 많이 낼 수는 없다 (모자라면 올인)
+    std::uint32_t put_chips(size_t s, std::uint32_t amount) {
+        auto& seat = seats[s];
+        amount = std::min(amount, seat.chips);
+        seat.chips -= amount;
+        seat.round_bet += amount;
+        seat.total_bet += amount;
+        pot += amount;
+        return amount;
+    }
+
+    // street 의 좌석 카드(좌석 순서대로 down → up) 와 공용 카드
+    void deal_street() {
+        const auto& plan = V::STREETS[street];
+        const size_t first = Traits::HOLE_BEFORE[street];
+        for (size_t s = 0; s < seat_count; ++s) {
+            if (!seats[s].live) continue;
+            for (size_t k = 0; k < plan.down + plan.up; ++k) seats[s].hand[first + k] = deck[top++];
+        }
+        for (size_t k = 0; k < plan.board; ++k) board[Traits::BOARD_BEFORE[street] + k] = deck[top++];
+    }
+
+    // to_act 부터 결정을 내려야 하는 좌석을 찾는다. 폴드한 좌석은 건너뛰고
+    // 칩이 0인 좌석은 액션한 것으로 센다. 모두 액션했으면 다음 스트리트, 마지막이면 쇼다운
+    void advance() {
+        while (true) {
+            while (actions_without_raise < active) {
+                const auto& seat = seats[to_act];
+                if (seat.live && seat.chips > 0) return;
+                if (seat.live) ++actions_without_raise;
+                to_act = static_cast<std::uint8_t>(seat_after(to_act, 1));
+            }
+            if constexpr (Traits::STREET_COUNT > 1) {
+                if (street + 1u < Traits::STREET_COUNT) {
+                    next_street();
+                    continue;
+                }
+            }
+            showdown();
+            return;
+        }
+    }
+
+    // 베팅을 비우고 다음 카드를 나눠준다. 칩이 남은 좌석이 둘 미만이면 베팅 없이 넘어간다
+    void next_street() {
+        ++street;
+        deal_street();
+        for (auto& seat : seats) seat.round_bet = 0;
+        current_bet = 0;
+        to_act = static_cast<std::uint8_t>(seat_after(dealer, 1));
+
+        size_t can_bet = 0;
+        for (size_t s = 0; s < seat_count; ++s) can_bet += seats[s].live && seats[s].chips > 0;
+        actions_without_raise = can_bet < 2 ? active : 0;
+    }
+
+    // 1. 가장 많이 낸 좌석이 두 번째보다 더 낸 만큼은 아무도 맞추지 않았으므로 돌려준다
+    // 2. 한 명만 남았으면 평가 없이 그 좌석이 전부 (홀덤 프리플랍처럼 5장이 안 될 수도 있다)
+    // 3. 아니면 남은 좌석의 낸 금액을 낮은 순으로 잘라 팟을 만들고, 팟마다 그만큼 낸 좌석끼리 겨룬다
+    //    폴드한 좌석의 칩은 자기가 낸 만큼까지의 팟에 들어간다
+    void showdown() {
+        size_t top = 0, second = 0;
+        for (size_t s = 1; s < seat_count; ++s) {
+            if (seats[s].total_bet > seats[top].total_bet) {
+                second = top;
+                top = s;
+            } else if (s == 1 || seats[s].total_bet > seats[second].total_bet) {
+                second = s;
+            }
+        }
+        if (seats[top].total_bet > seats[second].total_bet) {
+            uncalled = seats[top].total_bet - seats[second].total_bet;
+            uncalled_seat = static_cast<std::uint8_t>(top);
+            seats[top].total_bet -= uncalled;
+            seats[top].chips += uncalled;
+            pot -= uncalled;
+        }
+
+        if (active == 1) {
+            for (size_t s = 0; s < seat_count; ++s) {
+                if (seats[s].live) award(s, pot);
+            }
+        } else {
+            std::array<std::uint32_t, MAX_SEATS> value{};
+            std::array<std::uint32_t, MAX_SEATS> left{};
+            for (size_t s = 0; s < seat_count; ++s) {
+                if (seats[s].live) value[s] = evaluate(visible(s)).packed();
+                left[s] = seats[s].total_bet;
+            }
+            while (true) {
+                // 다음 팟의 높이 = 아직 덜 나눈 live 좌석 중 가장 적게 낸 금액
+                std::uint32_t level = UINT32_MAX;
+                for (size_t s = 0; s < seat_count; ++s) {
+                    if (seats[s].live && left[s] > 0) level = std::min(level, left[s]);
+                }
+                if (level == UINT32_MAX) break;
+
+                std::uint32_t amount = 0;
+                std::uint16_t eligible = 0;
+                for (size_t s = 0; s < seat_count; ++s) {
+                    auto part = std::min(left[s], level);
+                    amount += part;
+                    left[s] -= part;
+                    if (seats[s].live && part == level) eligible |= static_cast<std::uint16_t>(1u << s);
+                }
+                // 마지막 팟이면 live 좌석보다 더 내고 폴드한 칩도 여기에
+                bool last = true;
+                for (size_t s = 0; s < seat_count; ++s) last = last && !(seats[s].live && left[s] > 0);
+                if (last) {
+                    for (size_t s = 0; s < seat_count; ++s) amount += std::exchange(left[s], 0u);
+                }
+                split(amount, eligible, value);
+            }
+        }
+        // 데드 버튼은 쓰지 않는다. 버튼은 칩이 남은 다음 좌석으로 (방금 탈락한 좌석은 건너뛴다)
+        dealer = static_cast<std::uint8_t>(next_funded(dealer));
+        finished = true;
+    }
+
+    void award(size_t seat, std::uint32_t amount) {
+        seats[seat].chips += amount;
+        seats[seat].won += amount;
+        if (amount) winners |= static_cast<std::uint16_t>(1u << seat);
+    }
+
+    // 팟 하나를 eligible 좌석 중 가장 높은 핸드끼리 나눈다 (나머지 칩은 앞 좌석 승자에게)
+    void split(std::uint32_t amount, std::uint16_t eligible, const std::array<std::uint32_t, MAX_SEATS>& value) {
+        std::uint32_t best = 0;
+        std::uint16_t best_seats = 0;
+        for (size_t s = 0; s < seat_count; ++s) {
+            if (!((eligible >> s) & 1)) continue;
+            if (best_seats == 0 || value[s] > best) {
+                best = value[s];
+                best_seats = static_cast<std::uint16_t>(1u << s);
+            } else if (value[s] == best) {
+                best_seats |= static_cast<std::uint16_t>(1u << s);
+            }
+        }
+        auto count = static_cast<std::uint32_t>(std::popcount(best_seats));
+        std::uint32_t share = amount / count;
+        for (size_t s = 0; s < seat_count; ++s) {
+            if ((best_seats >> s) & 1) award(s, share);
+        }
+        award(static_cast<size_t>(std::countr_zero(best_seats)), amount - share * count);
+    }
+};
+
+using GameState = BasicGameState<FiveCardDraw>;
+
+static_assert(std::is_trivially_copyable_v<GameState>, "GameState must stay memcpy-able");
+static_assert(std::is_trivially_copyable_v<BasicGameState<SevenCardStud>>, "GameState must stay memcpy-able");
+// 사이드 팟용 total_bet / won 까지 6 캐시라인
+static_assert(sizeof(GameState) <= 384, "GameState should stay a few cache lines");
+
+} // namespace poker
@@ -4,6 +4,9 @@
 #include "concepts.hpp"
 #include <array>
 #include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <functional>
 
 namespace poker {
 
@@ -24,7 +27,28 @@ struct HandValue {
     HandRank rank;
     std::array<Rank, 5> tiebreakers{};
 
-    auto operator<=>(const HandValue&) const = default;
+    // 32비트 하나로: rank << 20 | 타이브레이커 5개를 4비트씩 (빈 자리는 0)
+    // 높은 자리부터 사전식 순서 그대로라 정수 비교 = HandValue 비교
+    constexpr std::uint32_t packed() const {
+        std::uint32_t p = static_cast<std::uint32_t>(rank);
+        for (auto r : tiebreakers) p = (p << 4) | static_cast<std::uint32_t>(r);
+        return p;
+    }
+
+    static constexpr HandValue unpack(std::uint32_t p) {
+        HandValue v{};
+        for (size_t i = 5; i-- > 0; p >>= 4) v.tiebreakers[i] = static_cast<Rank>(p & 0xF);
+        v.rank = static_cast<HandRank>(p);
+        return v;
+    }
+
+    constexpr std::strong_ordering operator<=>(const HandValue& other) const {
+        return packed() <=> other.packed();
+    }
+
+    constexpr bool operator==(const HandValue& other) const {
+        return packed() == other.packed();
+    }
 };
 
 template<size_t N>
@@ -263,4 +287,9 @@ private:
 };
 
 
-} // namespace poker
\ No newline at end of file
+} // namespace poker
+
+template<>
+struct std::hash<poker::HandValue> {
+    size_t operator()(const poker::HandValue& v) const noexcept { return v.packed(); }
+};
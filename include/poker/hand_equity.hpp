@@ -0,0 +1,242 @@
+#pragma once
+
+#include "card_set.hpp"
+#include "equity.hpp"
+#include "evaluator.hpp"
+#include "hand.hpp"
+#include "hand_indexer.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace poker {
+
+namespace detail {
+
+    // 강도 등급 하나 = 같은 HandValue 를 내는 랭크 구성 (플러시 여부 포함). 5장 전체에 7462개
+    struct StrengthClass {
+        std::uint32_t value{0};             // HandValue::packed()
+        std::uint16_t ranks{0};             // 랭크 마스크 (비트 r = 랭크 r + 2)
+        std::array<std::uint8_t, 5> rank{};  // 랭크별 장수 (groups 개)
+        std::array<std::uint8_t, 5> count{};
+        std::uint8_t groups{0};
+        bool flush{false};
+    };
+
+    inline constexpr auto SMALL_CHOOSE = [] {
+        std::array<std::array<std::uint32_t, 5>, 5> table{};
+        for (std::uint32_t n = 0; n < 5; ++n) table[n] = {1, n, n * (n - 1) / 2,
+                                                          n * (n - 1) * (n - 2) / 6, n == 4 ? 1u : 0u};
+        return table;
+    }();
+
+} // namespace detail
+
+/*
+Hand<5> 대 무작위 상대 핸드의 정확한 승률 (5카드 드로우, 교환 전)
+
+    const auto& table = HandEquity::shared();
+    auto r = table.heads_up(hand);          // 남은 47장에서 나올 수 있는 상대 핸드 1,533,939개 전부
+    double e = table.equity(hand, 3);       // 상대 3명 근사
+
+1. 강도 등급 7462개를 HandValue 순으로 정렬하고, 막힌 카드가 없을 때의 등급별 조합 수 누적 분포를 만든다
+   - 플러시가 아닌 등급: 랭크별 C(4, k) 곱 (5랭크가 다르면 같은 수트 4개 제외)
+   - 플러시 등급: 수트 4개
+2. 우리 카드 5장은 상대가 못 쓰므로 우리 랭크가 들어간 등급만 C(4 - 막힌 수, k) 로 다시 세서
+   누적 분포에서 빠진 만큼 뺀다 (랭크가 겹치지 않는 등급은 마스크 검사 한 번으로 건너뛴다)
+3. 결과는 수트 동형 인덱스(134,459칸) 별로 한 번만 계산해서 보관한다. 두 번째부터는
+   인덱스 계산 + 원자적 읽기 하나라 150ns 안팎. precompute() 로 미리 다 채울 수도 있다
+
+여러 명은 상대끼리 카드가 겹치는 효과를 무시하고 독립으로 근사한다: 모두 이길 확률 = w^n,
+에퀴티 = Σ C(n,k) t^k w^(n-k) / (k+1) (k명과 비기고 나머지를 이긴 경우 팟을 k+1로 나눔)
+*/
+class HandEquity {
+public:
+    static constexpr std::uint32_t OPPONENT_HANDS = 1'533'939;   // C(47, 5)
+
+    HandEquity() : indexer_{5}, memo_(std::make_unique<std::atomic<std::uint64_t>[]>(indexer_.size())) {
+        build_classes();
+    }
+
+    // 프로세스 전체가 같이 쓰는 테이블 (처음 부를 때 만든다)
+    static const HandEquity& shared() {
+        static const HandEquity table;
+        return table;
+    }
+
+    EquityResult heads_up(CardSet cards) const {
+        if (cards.size() != 5) throw std::invalid_argument("HandEquity needs exactly five cards");
+        auto [win, tie] = counts(cards);
+        EquityResult result;
+        result.win = static_cast<double>(win) / OPPONENT_HANDS;
+        result.tie = static_cast<double>(tie) / OPPONENT_HANDS;
+        result.lose = static_cast<double>(OPPONENT_HANDS - win - tie) / OPPONENT_HANDS;
+        result.samples = OPPONENT_HANDS;
+        result.exhaustive = true;
+        return result;
+    }
+
+    EquityResult heads_up(const Hand<5>& hand) const {
+        return heads_up(CardSet{hand});
+    }
+
+    // 팟 지분 (비기면 나눠 가진다)
+    double equity(const Hand<5>& hand, size_t opponents = 1) const {
+        auto r = heads_up(hand);
+        if (opponents <= 1) return r.equity();
+        double share = 0.0, tie_power = 1.0;
+        for (size_t k = 0; k <= opponents; ++k) {
+            double ways = static_cast<double>(detail::choose(opponents, k));
+            share += ways * tie_power * power(r.win, opponents - k) / static_cast<double>(k + 1);
+            tie_power *= r.tie;
+        }
+        return share;
+    }
+
+    // 상대 모두를 단독으로 이길 확률
+    double win_probability(const Hand<5>& hand, size_t opponents = 1) const {
+        return power(heads_up(hand).win, std::max<size_t>(opponents, 1));
+    }
+
+    // 모든 수트 동형 칸을 미리 계산 (한 칸 10µs 안팎, 전체 1초 남짓 / 코어)
+    void precompute(unsigned threads = 0) const {
+        parallel_for(static_cast<size_t>(indexer_.size()), threads, [&](size_t i, unsigned) {
+            if (memo_[i].load(std::memory_order_relaxed) == 0) {
+                memo_[i].store(pack(compute(indexer_.unindex(i)[0])), std::memory_order_relaxed);
+            }
+        });
+    }
+
+    size_t classes() const { return classes_.size(); }
+
+private:
+    struct Counts {
+        std::uint32_t win{0};   // 우리보다 약한 상대 핸드 수
+        std::uint32_t tie{0};
+    };
+
+    static constexpr std::uint64_t FILLED = std::uint64_t{1} << 63;
+
+    HandIndexer indexer_;
+    std::vector<detail::StrengthClass> classes_;   // HandValue 오름차순
+    std::vector<std::uint32_t> below_;             // below_[i] = 막힘 없이 등급 [0, i) 의 조합 수
+    // 수트 동형 칸별 결과. 0 = 아직 없음. 여러 스레드가 같은 칸을 동시에 채워도 값이 같아서 relaxed 로 충분
+    mutable std::unique_ptr<std::atomic<std::uint64_t>[]> memo_;
+
+    static double power(double base, size_t exponent) {
+        double r = 1.0;
+        for (; exponent; --exponent) r *= base;
+        return r;
+    }
+
+    static std::uint64_t pack(Counts c) {
+        return FILLED | (std::uint64_t{c.tie} << 32) | c.win;
+    }
+
+    Counts counts(CardSet cards) const {
+        auto& slot = memo_[indexer_.index(cards)];
+        std::uint64_t packed = slot.load(std::memory_order_relaxed);
+        if (packed == 0) {
+            packed = pack(compute(cards));
+            slot.store(packed, std::memory_order_relaxed);
+        }
+        return {static_cast<std::uint32_t>(packed), static_cast<std::uint32_t>(packed >> 32) & 0x7FFFFFFFu};
+    }
+
+    static std::array<std::uint16_t, 4> suit_masks(CardSet cards) {
+        return {cards.suit_mask(Suit::Clubs), cards.suit_mask(Suit::Diamonds),
+                cards.suit_mask(Suit::Hearts), cards.suit_mask(Suit::Spades)};
+    }
+
+    // 수트 masks 의 카드가 막혀 있을 때 이 등급을 만드는 상대 조합 수
+    static std::uint32_t combos(const detail::StrengthClass& c, const std::array<std::uint16_t, 4>& masks,
+                                const std::array<std::uint8_t, 13>& blocked) {
+        std::uint32_t flushes = 0;
+        if (c.groups == 5) {
+            for (auto m : masks) flushes += (m & c.ranks) == 0;
+            if (c.flush) return flushes;
+        }
+        std::uint32_t n = 1;
+        for (size_t g = 0; g < c.groups; ++g) n *= detail::SMALL_CHOOSE[4 - blocked[c.rank[g]]][c.count[g]];
+        return n - flushes;
+    }
+
+    Counts compute(CardSet cards) const {
+        const auto masks = suit_masks(cards);
+        const std::uint32_t value = detail::evaluate_masks(masks).packed();
+        const auto mine = static_cast<std::uint16_t>(masks[0] | masks[1] | masks[2] | masks[3]);
+        std::array<std::uint8_t, 13> blocked{};
+        for (auto m : masks) {
+            for (; m; m &= m - 1) ++blocked[std::countr_zero(m)];
+        }
+
+        // 막힘 없는 누적 분포에서 시작
+        auto by_value = [](const detail::StrengthClass& c, std::uint32_t v) { return c.value < v; };
+        auto lo = static_cast<size_t>(std::lower_bound(classes_.begin(), classes_.end(), value, by_value) - classes_.begin());
+        size_t hi = lo;
+        while (hi < classes_.size() && classes_[hi].value == value) ++hi;
+        std::uint32_t win = below_[lo];
+        std::uint32_t tie = below_[hi] - below_[lo];
+
+        // 우리 랭크가 들어간 등급만 막힌 카드만큼 뺀다 (이기는 쪽은 나머지라 따로 셀 필요 없음)
+        for (size_t i = 0; i < hi; ++i) {
+            const auto& c = classes_[i];
+            if ((c.ranks & mine) == 0) continue;
+            std::uint32_t removed = below_[i + 1] - below_[i] - combos(c, masks, blocked);
+            (i < lo ? win : tie) -= removed;
+        }
+        return {win, tie};
+    }
+
+    void build_classes() {
+        // 랭크별 장수 (합 5, 랭크당 최대 4) 를 전부 나열
+        std::array<std::uint8_t, 13> count{};
+        auto add = [&] {
+            detail::StrengthClass c;
+            std::array<std::uint16_t, 4> masks{};
+            for (std::uint8_t r = 0; r < 13; ++r) {
+                if (count[r] == 0) continue;
+                c.ranks = static_cast<std::uint16_t>(c.ranks | (1u << r));
+                c.rank[c.groups] = r;
+                c.count[c.groups++] = count[r];
+                for (size_t s = 0; s < count[r]; ++s) masks[s] = static_cast<std::uint16_t>(masks[s] | (1u << r));
+            }
+            if (c.groups == 5) {
+                // 5랭크가 다 다르면 한 장만 다른 수트로 옮겨 플러시가 아닌 대표 핸드를 만든다
+                std::uint16_t low = static_cast<std::uint16_t>(c.ranks & -c.ranks);
+                classes_.push_back(c);
+                classes_.back().flush = true;
+                classes_.back().value = detail::evaluate_masks({c.ranks, 0, 0, 0}).packed();
+                masks = {static_cast<std::uint16_t>(c.ranks ^ low), low, 0, 0};
+            }
+            c.value = detail::evaluate_masks(masks).packed();
+            classes_.push_back(c);
+        };
+        auto enumerate = [&](auto& self, std::uint8_t r, std::uint8_t left) -> void {
+            if (left == 0) { add(); return; }
+            if (r == 13) return;
+            for (std::uint8_t k = std::min<std::uint8_t>(left, 4);; --k) {
+                count[r] = k;
+                self(self, static_cast<std::uint8_t>(r + 1), static_cast<std::uint8_t>(left - k));
+                if (k == 0) break;
+            }
+            count[r] = 0;
+        };
+        enumerate(enumerate, 0, 5);
+
+        std::sort(classes_.begin(), classes_.end(), [](const auto& a, const auto& b) { return a.value < b.value; });
+        below_.assign(classes_.size() + 1, 0);
+        const std::array<std::uint16_t, 4> open{};
+        const std::array<std::uint8_t, 13> none{};
+        for (size_t i = 0; i < classes_.size(); ++i) below_[i + 1] = below_[i] + combos(classes_[i], open, none);
+        if (below_.back() != detail::choose(52, 5)) throw std::logic_error("HandEquity class table is inconsistent");
+    }
+};
+
+} // namespace poker
@@ -0,0 +1,512 @@
+#pragma once
+
+#include "action.hpp"
+#include "card_set.hpp"
+#include "event_ring.hpp"
+#include "hand.hpp"
+#include "packed.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace poker {
+
+enum class HistoryEventType : std::uint8_t {
+    HandStart,  // amount = 유닉스 시각, detail = 버튼 좌석, player = register_game() 이 준 번호
+    Seat,       // amount = 시작 칩
+    Blind,      // amount = 금액, detail = 0(SB) / 1(BB)
+    Deal,       // cards = 받은 카드, detail = HistoryStreet (공용 카드면 seat = HistoryEvent::BOARD)
+    Action,     // amount = 낸 칩 (벳/레이즈면 올린 폭), total = 액션 후 베팅액, detail = Action
+    Show,       // cards = 쇼다운 카드, detail = HandRank
+    Uncalled,   // amount = 아무도 맞추지 않아 돌려받은 칩
+    Collect,    // amount = 가져간 칩
+    HandEnd     // amount = 총 팟
+};
+
+// Deal 이벤트를 어느 스트리트 표시 아래에 쓸지 (스터드는 STUD + 그때까지 받은 카드 수 = "3rd STREET")
+enum class HistoryStreet : std::uint8_t {
+    DealingHands,   // 드로우: *** DEALING HANDS ***
+    HoleCards,      // 홀덤 프리플랍: *** HOLE CARDS ***
+    Flop,
+    Turn,
+    River,          // 홀덤 리버, 7카드 스터드 마지막 장
+    Stud = 16
+};
+
+// 테이블 스레드가 만드는 고정 크기 이벤트. 문자열 포맷은 백그라운드 스레드가 한다.
+struct HistoryEvent {
+    static constexpr std::uint8_t BOARD = 0xFF;     // 공용 카드 Deal 의 seat
+
+    std::uint64_t hand_id{0};
+    std::uint32_t amount{0};
+    std::uint32_t total{0};
+    std::uint32_t table_id{0};
+    std::uint16_t player{0};        // register_player() 가 준 번호
+    HistoryEventType type{HistoryEventType::HandStart};
+    std::uint8_t seat{0};
+    std::uint8_t detail{0};
+    std::array<PackedCard, 5> cards{};
+    std::uint8_t card_count{0};
+};
+static_assert(sizeof(HistoryEvent) == 32, "HistoryEvent should stay one half cache line");
+
+// 큐가 가득 찼을 때의 처리
+enum class Backpressure {
+    Drop,   // 버리고 dropped() 카운트
+    Block,  // 자리가 날 때까지 테이블 스레드가 기다림
+    Spill   // 메모리 오버플로 목록에 쌓음 (파일은 여전히 백그라운드 스레드만 씀)
+};
+
+struct HistoryOptions {
+    std::string path_prefix{"hand_history"};        // prefix.0001.txt, prefix.0002.txt, ...
+    size_t queue_capacity{1 << 16};                 // 이벤트 개수
+    size_t buffer_bytes{1 << 20};                   // 이만큼 모이면 fwrite 한 번
+    std::uint64_t max_file_bytes{64ull << 20};      // 넘으면 다음 파일로
+    Backpressure backpressure{Backpressure::Block};
+    std::chrono::milliseconds flush_interval{200};  // 한가할 때 버퍼를 비우는 주기
+};
+
+/*
+비동기 핸드 히스토리 기록기 (PokerStars 스타일 텍스트)
+
+테이블 스레드: publish(HistoryEvent) → 고정 크기 레코드를 MpscRing 에 넣기만 한다 (락 없음)
+백그라운드 스레드: 링을 한 번에 비워서 큰 버퍼에 포맷하고,
+                  buffer_bytes 이상 모이면 fwrite 한 번, max_file_bytes 넘으면 파일 교체
+기록 스레드는 링이 비었을 때만 잠들고(idle_), 그때만 생산자가 뮤텍스를 잡고 깨운다.
+파일을 열거나 쓰지 못하면 기록 스레드가 예외를 잡아 error() 에 남기고 그 뒤 이벤트는 버린다.
+flush() 가 그 예외를 다시 던지고, 한 번도 알리지 못한 채 소멸하면 stderr 에 쓴다.
+*/
+class HandHistoryExporter {
+public:
+    explicit HandHistoryExporter(HistoryOptions options = {})
+        : options_(std::move(options)),
+          ring_(options_.queue_capacity)
+    {
+        if (options_.queue_capacity == 0) {
+            throw std::invalid_argument("queue_capacity must be positive");
+        }
+        buffer_.reserve(options_.buffer_bytes + 4096);
+        writer_ = std::thread([this] { run(); });
+    }
+
+    ~HandHistoryExporter() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        not_empty_.notify_one();
+        writer_.join();
+        if (error_ && !reported_) {
+            try {
+                std::rethrow_exception(error_);
+            } catch (const std::exception& e) {
+                std::fprintf(stderr, "Hand history lost: %s\n", e.what());
+            }
+        }
+    }
+
+    HandHistoryExporter(const HandHistoryExporter&) = delete;
+    HandHistoryExporter& operator=(const HandHistoryExporter&) = delete;
+
+    // 테이블 준비 단계에서 한 번 (이름은 포맷 스레드만 읽는다)
+    std::uint16_t register_player(std::string_view name) {
+        std::lock_guard lock(names_mutex_);
+        names_.emplace_back(name);
+        return static_cast<std::uint16_t>(names_.size() - 1);
+    }
+
+    // 게임 이름 (헤더 줄에 쓴다). 같은 이름은 같은 번호
+    std::uint16_t register_game(std::string_view name) {
+        std::lock_guard lock(names_mutex_);
+        auto it = std::find(games_.begin(), games_.end(), name);
+        if (it == games_.end()) it = games_.emplace(games_.end(), name);
+        return static_cast<std::uint16_t>(it - games_.begin());
+    }
+
+    // false = Drop 정책에서 버려졌거나 기록이 이미 실패함
+    bool publish(const HistoryEvent& event) {
+        if (failed_.load(std::memory_order_acquire)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        switch (options_.backpressure) {
+            case Backpressure::Drop:
+                if (!ring_.try_push(event)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                break;
+            case Backpressure::Spill:
+                // 한 번 넘치기 시작하면 기록 스레드가 spill 을 비울 때까지 순서를 지키려고 계속 spill 로
+                if (spilling_.load(std::memory_order_acquire) || !ring_.try_push(event)) {
+                    std::lock_guard lock(mutex_);
+                    spill_.push_back(event);
+                    spilling_.store(true, std::memory_order_release);
+                    not_empty_.notify_one();
+                    return true;
+                }
+                break;
+            case Backpressure::Block:
+                ring_.push(event);
+                break;
+        }
+        wake_writer();
+        return true;
+    }
+
+    // 지금까지 publish 된 이벤트가 파일에 써질 때까지 기다린다. 기록이 실패했으면 그 예외를 던진다
+    void flush() {
+        std::unique_lock lock(mutex_);
+        std::uint64_t target = ++flush_requested_;
+        not_empty_.notify_one();
+        flushed_.wait(lock, [&] { return flush_done_ >= target; });
+        if (error_) {
+            reported_ = true;
+            std::rethrow_exception(error_);
+        }
+    }
+
+    // 기록 스레드가 멈춘 원인 (nullptr = 정상)
+    std::exception_ptr error() {
+        std::lock_guard lock(mutex_);
+        return error_;
+    }
+
+    std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+    std::uint64_t bytes_written() const { return bytes_written_.load(std::memory_order_relaxed); }
+    std::uint32_t files_opened() const { return file_number_.load(std::memory_order_relaxed); }
+
+private:
+    HistoryOptions options_;
+
+    // 테이블 스레드 → 기록 스레드
+    MpscRing<HistoryEvent> ring_;
+    std::atomic<bool> idle_{false};       // 기록 스레드가 잠들려는 중 (생산자가 깨워야 함)
+    std::atomic<bool> spilling_{false};   // spill_ 에 이벤트가 있다
+    std::atomic<bool> failed_{false};     // 기록 실패. 이후 publish 는 버린다
+
+    // 잠들기/깨우기, spill, flush, 종료만 뮤텍스로
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable flushed_;
+    std::deque<HistoryEvent> spill_;
+    bool stopping_{false};
+    std::uint64_t flush_requested_{0};
+    std::uint64_t flush_done_{0};
+    std::exception_ptr error_;
+    bool reported_{false};              // flush() 로 알렸다
+
+    std::mutex names_mutex_;
+    std::deque<std::string> names_;
+    std::deque<std::string> games_;
+
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> bytes_written_{0};
+    std::atomic<std::uint32_t> file_number_{0};
+
+    // 기록 스레드 전용
+    std::thread writer_;
+    std::string buffer_;
+    std::FILE* file_{nullptr};
+    std::uint64_t file_bytes_{0};
+
+    // 여러 테이블 이벤트가 섞여 들어오므로 테이블별로 핸드 텍스트를 모았다가
+    // HandEnd 에서 통째로 buffer_ 에 옮긴다 (파일에는 완성된 핸드만 연속으로)
+    struct TableText {
+        std::string text;
+        std::uint64_t hand_id{0};
+        bool started{false};        // HandStart 를 받았는지 (Drop 정책에서 잘린 핸드 걸러내기)
+        std::uint8_t street{0xFF};      // 마지막으로 쓴 HistoryStreet 표시
+        bool showdown_started{false};
+        std::array<PackedCard, 5> board{};
+        std::uint8_t board_count{0};
+    };
+    std::unordered_map<std::uint32_t, TableText> tables_;
+    std::string* out_{nullptr};
+
+    // 생산자 쪽: 이벤트를 링에 넣은 뒤, 기록 스레드가 잠들려는 중일 때만 뮤텍스를 잡는다
+    void wake_writer() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (!idle_.load(std::memory_order_relaxed)) return;
+        std::lock_guard lock(mutex_);
+        not_empty_.notify_one();
+    }
+
+    // 링이 비어 있으면 flush_interval 동안 (또는 깨울 때까지) 잔다
+    void wait_for_events() {
+        if (!ring_.empty()) return;
+        idle_.store(true, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock lock(mutex_);
+            not_empty_.wait_for(lock, options_.flush_interval, [this] {
+                return !ring_.empty() || !spill_.empty() || stopping_ || flush_requested_ > flush_done_;
+            });
+        }
+        idle_.store(false, std::memory_order_relaxed);
+    }
+
+    void run() {
+        std::vector<HistoryEvent> batch;
+        batch.reserve(ring_.capacity());
+
+        while (true) {
+            wait_for_events();
+
+            // 링과 spill 을 같은 락 안에서 비운다. spill 은 링이 찼을 때부터 쌓였으므로 링보다 나중 이벤트지만,
+            // 락 밖에서 링을 비우면 그 사이 링에 들어간 이벤트가 이번 spill 뒤로 밀린다
+            batch.clear();
+            auto take = [&](const HistoryEvent& event) { batch.push_back(event); };
+
+            std::uint64_t flush_target = 0;
+            bool stopping = false;
+            {
+                std::lock_guard lock(mutex_);
+                ring_.drain(take);
+                if (!spill_.empty()) {
+                    // spill 중에는 새 이벤트가 링에 들어가지 않는다. 티켓만 받고 쓰는 중인 생산자만 기다린다
+                    while (!ring_.settled()) ring_.drain(take);
+                    batch.insert(batch.end(), spill_.begin(), spill_.end());
+                    spill_.clear();
+                }
+                spilling_.store(false, std::memory_order_release);
+                flush_target = flush_requested_ > flush_done_ ? flush_requested_ : 0;
+                stopping = stopping_;
+            }
+
+            // 실패한 뒤에도 링은 계속 비운다 (Block 정책의 생산자가 멈추지 않게). 비운 이벤트는 버린다
+            bool idle = batch.empty();
+            if (!failed_.load(std::memory_order_relaxed)) {
+                try {
+                    {
+                        // spill 로 배치가 커져도 buffer_bytes 단위로 나눠 써서 파일 크기 제한을 지킨다
+                        std::lock_guard names(names_mutex_);
+                        for (auto& event : batch) {
+                            format(event);
+                            if (buffer_.size() >= options_.buffer_bytes) write_buffer();
+                        }
+                    }
+                    if (idle || flush_target || stopping) write_buffer();
+                } catch (...) {
+                    fail(std::current_exception());
+                }
+            }
+
+            if (flush_target) {
+                std::lock_guard lock(mutex_);
+                flush_done_ = flush_target;
+                flushed_.notify_all();
+            }
+            if (stopping && idle) break;
+        }
+
+        if (file_) std::fclose(file_);
+    }
+
+    // 기록 스레드에서만. 예외를 생산자 쪽에 넘기고 이후 이벤트를 받지 않는다
+    void fail(std::exception_ptr error) {
+        buffer_.clear();
+        tables_.clear();
+        if (file_) std::fclose(file_);
+        file_ = nullptr;
+        std::lock_guard lock(mutex_);
+        error_ = error;
+        failed_.store(true, std::memory_order_release);
+    }
+
+    // 버퍼 전체를 fwrite 한 번으로. buffer_ 에는 완성된 핸드만 있으므로 어디서 잘라도 핸드 경계
+    // 덜 써지면 (디스크 가득 등) 기록 실패로 던진다
+    void write_buffer() {
+        if (buffer_.empty()) return;
+        if (!file_ || (file_bytes_ > 0 && file_bytes_ + buffer_.size() > options_.max_file_bytes)) {
+            open_next_file();
+        }
+        const size_t written = std::fwrite(buffer_.data(), 1, buffer_.size(), file_);
+        if (written != buffer_.size() || std::fflush(file_) != 0) {
+            throw std::runtime_error("Short write to hand history file (" + std::to_string(written) + " of " +
+                                     std::to_string(buffer_.size()) + " bytes)");
+        }
+        file_bytes_ += buffer_.size();
+        bytes_written_.fetch_add(buffer_.size(), std::memory_order_relaxed);
+        buffer_.clear();
+    }
+
+    void open_next_file() {
+        if (file_) std::fclose(file_);
+        auto number = file_number_.fetch_add(1, std::memory_order_relaxed) + 1;
+        char suffix[16];
+        std::snprintf(suffix, sizeof(suffix), ".%04u.txt", number);
+        const auto path = options_.path_prefix + suffix;
+        file_ = std::fopen(path.c_str(), "wb");
+        if (!file_) throw std::runtime_error("Cannot open hand history file " + path);
+        std::setvbuf(file_, nullptr, _IONBF, 0);  // 우리 버퍼를 그대로 write 로
+        file_bytes_ = 0;
+    }
+
+    // ---- PokerStars 스타일 포맷 ----
+
+    const std::string& name(const HistoryEvent& e) const {
+        static const std::string unknown{"?"};
+        return e.player < names_.size() ? names_[e.player] : unknown;
+    }
+
+    const std::string& game_name(const HistoryEvent& e) const {
+        static const std::string unknown{"Poker"};
+        return e.player < games_.size() ? games_[e.player] : unknown;
+    }
+
+    void append(std::string_view s) { out_->append(s); }
+    void append(std::uint64_t v) { out_->append(std::to_string(v)); }
+
+    void append_cards(const PackedCard* cards, std::uint8_t count) {
+        static constexpr char RANKS[] = "23456789TJQKA";
+        static constexpr char SUITS[] = "cdhs";
+        *out_ += '[';
+        for (std::uint8_t i = 0; i < count; ++i) {
+            if (i) *out_ += ' ';
+            *out_ += RANKS[cards[i].index % 13];
+            *out_ += SUITS[cards[i].index / 13];
+        }
+        *out_ += ']';
+    }
+
+    static std::string street_name(std::uint8_t street) {
+        switch (static_cast<HistoryStreet>(street)) {
+            case HistoryStreet::DealingHands: return "DEALING HANDS";
+            case HistoryStreet::HoleCards:    return "HOLE CARDS";
+            case HistoryStreet::Flop:         return "FLOP";
+            case HistoryStreet::Turn:         return "TURN";
+            case HistoryStreet::River:        return "RIVER";
+            default: break;
+        }
+        const unsigned n = street - static_cast<unsigned>(HistoryStreet::Stud);
+        const char* suffix = n == 1 ? "st" : n == 2 ? "nd" : n == 3 ? "rd" : "th";
+        return std::to_string(n) + suffix + " STREET";
+    }
+
+    static std::string_view describe(HandRank rank) {
+        switch (rank) {
+            case HandRank::RoyalFlush:    return "a Royal Flush";
+            case HandRank::StraightFlush: return "a straight flush";
+            case HandRank::FourOfKind:    return "four of a kind";
+            case HandRank::FullHouse:     return "a full house";
+            case HandRank::Flush:         return "a flush";
+            case HandRank::Straight:      return "a straight";
+            case HandRank::ThreeOfKind:   return "three of a kind";
+            case HandRank::TwoPair:       return "two pair";
+            case HandRank::OnePair:       return "a pair";
+            default:                      return "high card";
+        }
+    }
+
+    void format(const HistoryEvent& e) {
+        auto& table = tables_[e.table_id];
+        out_ = &table.text;
+
+        if (e.type != HistoryEventType::HandStart && (!table.started || table.hand_id != e.hand_id)) {
+            return;  // 시작이 버려진 핸드
+        }
+
+        switch (e.type) {
+            case HistoryEventType::HandStart: {
+                table.text.clear();
+                table.hand_id = e.hand_id;
+                table.started = true;
+                table.street = 0xFF;
+                table.board_count = 0;
+                table.showdown_started = false;
+                std::time_t t = static_cast<std::time_t>(e.amount);
+                char date[32];
+                std::strftime(date, sizeof(date), "%Y/%m/%d %H:%M:%S", std::gmtime(&t));
+                append("PokerStars Hand #"); append(e.hand_id);
+                append(": "); append(game_name(e)); append(" No Limit - "); append(date); append(" UTC\n");
+                append("Table '"); append(e.table_id); append("' Seat #");
+                append(static_cast<std::uint64_t>(e.detail) + 1); append(" is the button\n");
+                break;
+            }
+            case HistoryEventType::Seat:
+                append("Seat "); append(static_cast<std::uint64_t>(e.seat) + 1); append(": ");
+                append(name(e)); append(" ("); append(e.amount); append(" in chips)\n");
+                break;
+            case HistoryEventType::Blind:
+                append(name(e)); append(e.detail ? ": posts big blind " : ": posts small blind ");
+                append(e.amount); append("\n");
+                break;
+            case HistoryEventType::Deal:
+                if (e.seat == HistoryEvent::BOARD) {
+                    // *** TURN *** [Ah Kd 2c] [7s]
+                    append("*** "); append(street_name(e.detail)); append(" *** ");
+                    if (table.board_count) {
+                        append_cards(table.board.data(), table.board_count);
+                        append(" ");
+                    }
+                    append_cards(e.cards.data(), e.card_count); append("\n");
+                    for (std::uint8_t i = 0; i < e.card_count && table.board_count < table.board.size(); ++i) {
+                        table.board[table.board_count++] = e.cards[i];
+                    }
+                    table.street = e.detail;
+                    break;
+                }
+                if (table.street != e.detail) {
+                    append("*** "); append(street_name(e.detail)); append(" ***\n");
+                    table.street = e.detail;
+                }
+                append("Dealt to "); append(name(e)); append(" "); append_cards(e.cards.data(), e.card_count); append("\n");
+                break;
+            case HistoryEventType::Action:
+                append(name(e));
+                switch (static_cast<poker::Action>(e.detail)) {
+                    case poker::Action::Fold:  append(": folds\n"); break;
+                    case poker::Action::Check: append(": checks\n"); break;
+                    case poker::Action::Call:  append(": calls "); append(e.amount); append("\n"); break;
+                    case poker::Action::Bet:
+                    case poker::Action::Raise:
+                        // 앞선 베팅(블라인드 포함)이 있으면 레이즈로 표기
+                        if (e.total > e.amount) {
+                            append(": raises "); append(e.amount); append(" to "); append(e.total); append("\n");
+                        } else {
+                            append(": bets "); append(e.amount); append("\n");
+                        }
+                        break;
+                    case poker::Action::AllIn:
+                        append(": bets "); append(e.amount); append(" and is all-in\n"); break;
+                }
+                break;
+            case HistoryEventType::Show:
+                if (!table.showdown_started) append("*** SHOW DOWN ***\n");
+                table.showdown_started = true;
+                append(name(e)); append(": shows "); append_cards(e.cards.data(), e.card_count); append(" (");
+                append(describe(static_cast<HandRank>(e.detail))); append(")\n");
+                break;
+            case HistoryEventType::Uncalled:
+                append("Uncalled bet ("); append(e.amount); append(") returned to "); append(name(e)); append("\n");
+                break;
+            case HistoryEventType::Collect:
+                append(name(e)); append(" collected "); append(e.amount); append(" from pot\n");
+                break;
+            case HistoryEventType::HandEnd:
+                append("*** SUMMARY ***\nTotal pot "); append(e.amount); append("\n\n");
+                buffer_ += table.text;
+                table.text.clear();
+                table.started = false;
+                break;
+        }
+    }
+};
+
+} // namespace poker
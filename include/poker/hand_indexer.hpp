@@ -0,0 +1,391 @@
+#pragma once
+
+#include "card_set.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace poker {
+
+/*
+수트 동형(suit isomorphism) 핸드 인덱서
+
+수트는 서로 바꿔도 핸드 가치가 같으므로 ♠♥ 를 ♣♦ 로 바꾼 핸드는 같은 칸을 쓴다.
+라운드(스트리트)별 카드 수를 받아 [0, size()) 의 조밀한 인덱스로 보내고, 되돌릴 수도 있다.
+
+    HandIndexer five{5};       // Hand<5>: 2,598,960 → 134,459
+    HandIndexer flop{2, 3};    // 홀카드 + 플롭: 1,286,792
+    HandIndexer turn{2, 4};    // 13,960,050
+    HandIndexer river{2, 5};   // 123,156,254
+
+인덱스 구성
+1. 수트마다 라운드별 카드 수 튜플을 만들고, 튜플 4개의 정렬된 묶음(configuration)을 찾는다
+2. 수트마다 라운드별 랭크 조합을 하나의 정수(suit index)로 만든다
+3. 같은 튜플을 가진 수트끼리는 순서가 의미 없으므로 중복 조합(multiset)으로 인덱싱한다
+4. index = configuration 시작 위치 + 그룹별 인덱스의 혼합 진법 조합
+
+index() 는 탐색 없이 표만 찾는다
+- 이전 라운드 랭크를 뺀 부분집합 인덱스: 낮은 7비트 / 높은 6비트 압축(pext) 표 → COLEX 표
+- configuration: 수트 튜플 → 작은 번호, 정렬된 번호 4개의 중복 조합 인덱스 → configuration 표
+*/
+class HandIndexer {
+public:
+    static constexpr size_t MAX_ROUNDS = 4;
+
+    HandIndexer(std::initializer_list<std::uint8_t> cards_per_round)
+        : rounds_(cards_per_round.size())
+    {
+        if (rounds_ == 0 || rounds_ > MAX_ROUNDS) {
+            throw std::invalid_argument("HandIndexer supports 1 to 4 rounds");
+        }
+        size_t total = 0;
+        size_t r = 0;
+        for (auto n : cards_per_round) {
+            cards_[r++] = n;
+            total += n;
+        }
+        if (total > 52) throw std::invalid_argument("Too many cards for HandIndexer");
+        build_configurations();
+    }
+
+    size_t rounds() const { return rounds_; }
+    std::uint64_t size() const { return size_; }
+
+    // 라운드가 하나인 인덱서만 (예: Hand<5>). 여러 라운드면 라운드별 카드를 span 으로 넘긴다
+    std::uint64_t index(CardSet cards) const {
+        if (rounds_ != 1) throw std::invalid_argument("HandIndexer::index(CardSet) needs a single-round indexer");
+        return index(std::span<const CardSet>(&cards, 1));
+    }
+
+    template<size_t N>
+    std::uint64_t index(const Hand<N>& hand) const {
+        return index(CardSet{hand});
+    }
+
+    // rounds[r] = r 라운드에 받은 카드 (rounds() 개)
+    std::uint64_t index(std::span<const CardSet> rounds) const {
+        if (rounds.size() != rounds_) throw std::invalid_argument("HandIndexer needs one CardSet per round");
+        // 수트마다 (튜플 << 48) | suit index 하나로 묶는다
+        std::array<std::uint64_t, 4> suits{};
+        for (int s = 0; s < 4; ++s) {
+            std::uint16_t used = 0;
+            std::uint64_t idx = 0;
+            std::uint64_t radix = 1;
+            std::uint64_t code = 0;
+            for (size_t r = 0; r < rounds_; ++r) {
+                auto mask = rounds[r].suit_mask(static_cast<Suit>(s));
+                int count = std::popcount(mask);
+                idx += radix * subset_index(mask, used);
+                radix *= BINOMIAL[13 - std::popcount(used)][count];
+                code |= static_cast<std::uint64_t>(count) << (4 * r);
+                used = static_cast<std::uint16_t>(used | mask);
+            }
+            suits[s] = (code << 48) | idx;
+        }
+
+        // 튜플 오름차순, 같으면 suit index 오름차순 (4개짜리 정렬 네트워크, 분기 없이 min/max)
+        auto order = [&](int a, int b) {
+            auto lo = std::min(suits[a], suits[b]);
+            suits[b] = std::max(suits[a], suits[b]);
+            suits[a] = lo;
+        };
+        order(0, 1); order(2, 3); order(0, 2); order(1, 3); order(1, 2);
+
+        // 튜플 번호도 오름차순 → 중복 조합 인덱스로 configuration 을 찾는다
+        std::uint64_t slot = 0;
+        for (int j = 0; j < 4; ++j) {
+            std::uint32_t id = code_ids_[suits[j] >> 48];
+            if (id == NO_ID) throw std::invalid_argument("Cards do not match the indexer's rounds");
+            slot += small_binomial(id + static_cast<std::uint64_t>(j), j + 1);
+        }
+        std::uint32_t found = slot < config_of_.size() ? config_of_[slot] : NO_ID;
+        if (found == NO_ID) throw std::invalid_argument("Cards do not match the indexer's rounds");
+        const Configuration& config = configs_[found];
+
+        // 그룹마다 multiset colex 인덱스 × 그룹 진법 (그룹 안 순번과 진법은 configuration 에 미리)
+        std::uint64_t result = 0;
+        for (int j = 0; j < 4; ++j) {
+            const unsigned rank = config.rank_in_group[j];
+            result += config.radix[j] * small_binomial((suits[j] & INDEX_MASK) + rank, rank + 1);
+        }
+        return config.offset + result;
+    }
+
+    // index → 대표 핸드 (라운드별 카드 집합). 수트는 ♣ ♦ ♥ ♠ 순서로 채운다.
+    std::vector<CardSet> unindex(std::uint64_t index) const {
+        if (index >= size_) throw std::out_of_range("Hand index out of range");
+
+        auto it = std::upper_bound(configs_.begin(), configs_.end(), index,
+            [](std::uint64_t i, const Configuration& c) { return i < c.offset; });
+        const Configuration& config = *(it - 1);
+        std::uint64_t rest = index - config.offset;
+
+        std::array<std::uint16_t, 4> codes{};
+        for (int s = 0; s < 4; ++s) {
+            codes[s] = static_cast<std::uint16_t>(config.key >> (16 * (3 - s)));
+        }
+
+        std::vector<CardSet> rounds(rounds_);
+        for (int i = 0, g = 0; i < 4; ++g) {
+            int k = 1;
+            while (i + k < 4 && codes[i + k] == codes[i]) ++k;
+
+            std::uint64_t size = config.group_sizes[g];
+            std::uint64_t group = rest % size;
+            rest /= size;
+
+            // colex 역변환: 큰 원소부터 찾는다
+            for (int j = k - 1; j >= 0; --j) {
+                std::uint64_t w = largest_below(group, static_cast<std::uint64_t>(j + 1));
+                group -= binomial(w, static_cast<std::uint64_t>(j + 1));
+                std::uint64_t suit_index = w - static_cast<std::uint64_t>(j);
+                // 오름차순 j 번째 = 내림차순 (k-1-j) 번째 수트
+                decode_suit(codes[i], suit_index, i + (k - 1 - j), rounds);
+            }
+            i += k;
+        }
+        return rounds;
+    }
+
+private:
+    struct Configuration {
+        std::uint64_t key{0};       // 정렬된 수트 튜플 4개 (16비트씩)
+        std::uint64_t offset{0};    // 이 configuration 의 첫 인덱스
+        std::array<std::uint64_t, 4> group_sizes{};  // 같은 튜플 수트 그룹별 경우의 수
+        // 튜플 오름차순 위치별: 그룹 안 순번, 그 그룹의 진법 (index() 가 그룹을 다시 찾지 않게)
+        std::array<std::uint8_t, 4> rank_in_group{};
+        std::array<std::uint64_t, 4> radix{};
+    };
+
+    static constexpr auto BINOMIAL = [] {
+        std::array<std::array<std::uint64_t, 14>, 14> table{};
+        for (size_t n = 0; n < 14; ++n) {
+            table[n][0] = 1;
+            for (size_t k = 1; k <= n; ++k) table[n][k] = table[n - 1][k - 1] + table[n - 1][k];
+        }
+        return table;
+    }();
+
+    static constexpr std::uint32_t NO_ID = UINT32_MAX;
+    static constexpr std::uint64_t INDEX_MASK = (std::uint64_t{1} << 48) - 1;
+
+    size_t rounds_;
+    std::array<std::uint8_t, MAX_ROUNDS> cards_{};
+    std::vector<Configuration> configs_;
+    std::vector<std::uint32_t> code_ids_;     // 수트 튜플 → 튜플 번호 (나올 수 없는 튜플은 NO_ID)
+    std::vector<std::uint32_t> config_of_;    // 튜플 번호 4개의 중복 조합 인덱스 → configs_ 위치
+    std::uint64_t size_{0};
+
+    // 그룹 크기는 최대 4 이므로 k <= 4 는 상수 나눗셈으로 처리
+    static std::uint64_t binomial(std::uint64_t n, std::uint64_t k) {
+        if (k > n) return 0;
+        if (n < 14) return BINOMIAL[n][k];
+        switch (k) {
+            case 0: return 1;
+            case 1: return n;
+            case 2: return n * (n - 1) / 2;
+            case 3: return n * (n - 1) * (n - 2) / 6;
+            case 4: return n * (n - 1) * (n - 2) / 6 * (n - 3) / 4;
+            default: break;
+        }
+        std::uint64_t r = 1;
+        for (std::uint64_t i = 1; i <= k; ++i) r = r * (n - k + i) / i;
+        return r;
+    }
+
+    // k = 1..4 (그룹 크기) 의 C(n, k) 를 분기 없이. 넷 다 계산하고 고른다 (쓰지 않는 값은 넘쳐도 된다)
+    static std::uint64_t small_binomial(std::uint64_t n, unsigned k) {
+        const std::uint64_t c1 = n;
+        const std::uint64_t c2 = c1 * (n - 1) / 2;
+        const std::uint64_t c3 = c2 * (n - 2) / 3;
+        const std::uint64_t c4 = c3 * (n - 3) / 4;
+        const std::array<std::uint64_t, 5> c{0, c1, c2, c3, c4};
+        return c[k];
+    }
+
+    // C(w, k) <= value 인 가장 큰 w
+    static std::uint64_t largest_below(std::uint64_t value, std::uint64_t k) {
+        std::uint64_t lo = k - 1, hi = k;
+        while (binomial(hi, k) <= value) hi *= 2;
+        while (hi - lo > 1) {
+            std::uint64_t mid = lo + (hi - lo) / 2;
+            (binomial(mid, k) <= value ? lo : hi) = mid;
+        }
+        return lo;
+    }
+
+    static std::uint64_t multiset_size(std::uint64_t m, int k) {
+        return binomial(m + static_cast<std::uint64_t>(k) - 1, static_cast<std::uint64_t>(k));
+    }
+
+    // 13비트 마스크 → 같은 크기 부분집합 사이의 colex 인덱스
+    static constexpr auto COLEX = [] {
+        std::array<std::uint16_t, 8192> table{};
+        for (unsigned mask = 0; mask < table.size(); ++mask) {
+            std::uint64_t idx = 0;
+            int j = 1;
+            for (unsigned m = mask; m; m &= m - 1, ++j) idx += BINOMIAL[std::countr_zero(m)][j];
+            table[mask] = static_cast<std::uint16_t>(idx);
+        }
+        return table;
+    }();
+
+    // COMPACT<BITS>[used << BITS | mask] = mask 에서 used 비트를 빼고 아래로 당긴 값 (BITS 비트 pext)
+    template<unsigned BITS>
+    static constexpr auto COMPACT = [] {
+        std::array<std::uint8_t, (1u << (2 * BITS))> table{};
+        for (unsigned used = 0; used < (1u << BITS); ++used) {
+            for (unsigned mask = 0; mask < (1u << BITS); ++mask) {
+                unsigned m = 0;
+                for (unsigned bit = 0, out = 0; bit < BITS; ++bit) {
+                    if (used & (1u << bit)) continue;
+                    m |= ((mask >> bit) & 1u) << out++;
+                }
+                table[(used << BITS) | mask] = static_cast<std::uint8_t>(m);
+            }
+        }
+        return table;
+    }();
+
+    // used 를 뺀 나머지 랭크들 사이에서 mask 의 colex 인덱스
+    // 13비트를 낮은 7 / 높은 6비트로 나눠 압축 표 두 번 + COLEX 표 한 번
+    static std::uint64_t subset_index(std::uint16_t mask, std::uint16_t used) {
+        if (!used) return COLEX[mask];
+        const unsigned low_used = used & 0x7Fu;
+        const unsigned low = COMPACT<7>[(low_used << 7) | (mask & 0x7Fu)];
+        const unsigned high = COMPACT<6>[((used >> 7) << 6) | (mask >> 7)];
+        return COLEX[low | (high << (7 - std::popcount(low_used)))];
+    }
+
+    // 라운드별 카드 수 튜플 하나에 가능한 suit index 개수
+    std::uint64_t suit_size(std::uint16_t code) const {
+        std::uint64_t size = 1;
+        int used = 0;
+        for (size_t r = 0; r < rounds_; ++r) {
+            int count = (code >> (4 * r)) & 0xF;
+            size *= BINOMIAL[13 - used][count];
+            used += count;
+        }
+        return size;
+    }
+
+    void decode_suit(std::uint16_t code, std::uint64_t idx, int suit, std::vector<CardSet>& rounds) const {
+        std::uint16_t used = 0;
+        for (size_t r = 0; r < rounds_; ++r) {
+            int count = (code >> (4 * r)) & 0xF;
+            std::uint64_t size = BINOMIAL[13 - std::popcount(used)][count];
+            std::uint64_t sub = idx % size;
+            idx /= size;
+
+            // 남은 랭크 중 colex 위치 → 실제 랭크
+            std::array<int, 13> free_ranks{};
+            int n = 0;
+            for (int rank = 0; rank < 13; ++rank) {
+                if (!(used & (1u << rank))) free_ranks[n++] = rank;
+            }
+            for (int j = count; j >= 1; --j) {
+                int pos = j - 1;
+                while (pos + 1 < n && BINOMIAL[pos + 1][j] <= sub) ++pos;
+                sub -= BINOMIAL[pos][j];
+                int rank = free_ranks[pos];
+                rounds[r].insert_index(suit * 13 + rank);
+                used = static_cast<std::uint16_t>(used | (1u << rank));
+            }
+        }
+    }
+
+    // 라운드별 카드를 4수트에 나누는 모든 경우를 정렬해서 configuration 목록을 만든다
+    void build_configurations() {
+        std::vector<std::uint64_t> keys;
+        std::array<std::array<int, MAX_ROUNDS>, 4> counts{};
+
+        auto emit = [&] {
+            std::array<std::uint16_t, 4> codes{};
+            for (int s = 0; s < 4; ++s) {
+                int total = 0;
+                for (size_t r = 0; r < rounds_; ++r) {
+                    total += counts[s][r];
+                    codes[s] = static_cast<std::uint16_t>(codes[s] | (counts[s][r] << (4 * r)));
+                }
+                if (total > 13) return;
+            }
+            std::sort(codes.begin(), codes.end(), std::greater<>{});
+            std::uint64_t key = 0;
+            for (auto c : codes) key = (key << 16) | c;
+            keys.push_back(key);
+        };
+
+        // 라운드 r, 수트 s 에 남은 카드 left 장을 나눈다
+        auto split = [&](auto& self, size_t r, int s, int left) -> void {
+            if (r == rounds_) { emit(); return; }
+            if (s == 3) {
+                counts[3][r] = left;
+                self(self, r + 1, 0, r + 1 < rounds_ ? cards_[r + 1] : 0);
+                return;
+            }
+            for (int c = 0; c <= std::min(left, 13); ++c) {
+                counts[s][r] = c;
+                self(self, r, s + 1, left - c);
+            }
+        };
+        split(split, 0, 0, cards_[0]);
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        for (auto key : keys) {
+            Configuration config{key, size_, {}};
+
+            std::array<std::uint16_t, 4> codes{};
+            for (int s = 0; s < 4; ++s) codes[s] = static_cast<std::uint16_t>(key >> (16 * (3 - s)));
+
+            std::uint64_t size = 1;
+            for (int i = 0, g = 0; i < 4; ++g) {
+                int k = 1;
+                while (i + k < 4 && codes[i + k] == codes[i]) ++k;
+                config.group_sizes[g] = multiset_size(suit_size(codes[i]), k);
+                // 내림차순 i + k - 1 - j 번째 = 오름차순 3 - i - k + 1 + j 번째가 그룹 안 j 번
+                for (int j = 0; j < k; ++j) {
+                    config.rank_in_group[4 - i - k + j] = static_cast<std::uint8_t>(j);
+                    config.radix[4 - i - k + j] = size;
+                }
+                size *= config.group_sizes[g];
+                i += k;
+            }
+            configs_.push_back(config);
+            size_ += size;
+        }
+        build_lookup();
+    }
+
+    // index() 용 표: 나오는 수트 튜플에 작은 번호를 (튜플 순서대로) 주고, configuration 마다
+    // 정렬된 번호 4개의 중복 조합 인덱스 칸에 configs_ 위치를 적는다
+    void build_lookup() {
+        code_ids_.assign(size_t{1} << (4 * rounds_), NO_ID);
+        for (const auto& config : configs_) {
+            for (int s = 0; s < 4; ++s) code_ids_[static_cast<std::uint16_t>(config.key >> (16 * s))] = 0;
+        }
+        std::uint32_t codes = 0;
+        for (auto& id : code_ids_) {
+            if (id != NO_ID) id = codes++;
+        }
+
+        config_of_.assign(multiset_size(codes, 4), NO_ID);
+        for (size_t c = 0; c < configs_.size(); ++c) {
+            std::uint64_t slot = 0;
+            for (int j = 0; j < 4; ++j) {
+                std::uint32_t id = code_ids_[static_cast<std::uint16_t>(configs_[c].key >> (16 * j))];
+                slot += binomial(id + static_cast<std::uint64_t>(j), static_cast<std::uint64_t>(j + 1));
+            }
+            config_of_[slot] = static_cast<std::uint32_t>(c);
+        }
+    }
+};
+
+} // namespace poker
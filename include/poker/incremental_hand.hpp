@@ -0,0 +1,172 @@
+#pragma once
+
+#include "card_set.hpp"
+#include "evaluator.hpp"
+#include "hand.hpp"
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstdint>
+#include <stdexcept>
+
+namespace poker {
+
+/*
+카드를 한 장씩 더하고 빼면서 평가 상태를 유지하는 핸드 (최대 7장)
+
+    IncrementalHand hand{hole_cards};
+    hand.add(flop...);      // O(1)
+    hand.category();        // O(1) 현재 족보
+    hand.remove(card);      // O(1), 보드 트리를 되돌아갈 때
+
+Hand<N> 처럼 매번 정렬하지 않는다. 상태는 수트별 랭크 마스크, 랭크/수트별 개수,
+"k장 이상인 랭크" 마스크 네 개이고, 스트레이트는 STRAIGHT_TABLE 한 번으로 찾는다.
+value() 는 evaluate(CardSet) 와 같은 HandValue 를 돌려준다.
+*/
+class IncrementalHand {
+public:
+    static constexpr size_t MAX_CARDS = 7;
+
+    constexpr IncrementalHand() = default;
+
+    constexpr explicit IncrementalHand(CardSet cards) {
+        if (cards.size() > MAX_CARDS) {
+            throw std::out_of_range("IncrementalHand holds at most 7 cards");
+        }
+        for (std::uint64_t b = cards.bits(); b; b &= b - 1) add_index(std::countr_zero(b));
+    }
+
+    constexpr void add(const Card& card) {
+        int i = card_index(card);
+        if (cards_.contains_index(i)) throw std::invalid_argument("Card is already in hand");
+        if (size_ == MAX_CARDS) throw std::out_of_range("IncrementalHand holds at most 7 cards");
+        add_index(i);
+    }
+
+    constexpr void remove(const Card& card) {
+        int i = card_index(card);
+        if (!cards_.contains_index(i)) throw std::invalid_argument("Card is not in hand");
+        remove_index(i);
+    }
+
+    // 인덱스 버전은 검사하지 않는다 (CardSet::insert_index 처럼 열거 루프용)
+    constexpr void add_index(int i) {
+        int suit = i / 13, rank = i % 13;
+        auto bit = static_cast<std::uint16_t>(1u << rank);
+        cards_.insert_index(i);
+        suits_[suit] |= bit;
+        ++suit_counts_[suit];
+        count_masks_[rank_counts_[rank]++] |= bit;
+        ++size_;
+    }
+
+    constexpr void remove_index(int i) {
+        int suit = i / 13, rank = i % 13;
+        auto bit = static_cast<std::uint16_t>(1u << rank);
+        cards_.erase_index(i);
+        suits_[suit] &= static_cast<std::uint16_t>(~bit);
+        --suit_counts_[suit];
+        count_masks_[--rank_counts_[rank]] &= static_cast<std::uint16_t>(~bit);
+        --size_;
+    }
+
+    constexpr CardSet cards() const { return cards_; }
+    constexpr size_t size() const { return size_; }
+
+    constexpr std::uint8_t rank_count(Rank rank) const {
+        return rank_counts_[static_cast<size_t>(rank) - 2];
+    }
+    constexpr std::uint8_t suit_count(Suit suit) const {
+        return suit_counts_[static_cast<size_t>(suit)];
+    }
+
+    // 현재 스트레이트를 이루는 5장의 랭크 마스크 (없으면 0)
+    constexpr std::uint16_t straight_mask() const {
+        return detail::STRAIGHT_TABLE[count_masks_[0]];
+    }
+
+    // 현재 족보만 (타이브레이커 없이). 분기 몇 개로 끝난다
+    constexpr HandRank category() const {
+        for (size_t s = 0; s < 4; ++s) {
+            if (suit_counts_[s] < 5) continue;
+            if (auto sf = detail::STRAIGHT_TABLE[suits_[s]]) {
+                return (sf & (1u << 12)) ? HandRank::RoyalFlush : HandRank::StraightFlush;
+            }
+            return HandRank::Flush;  // 7장 이하에서는 포카드/풀하우스와 공존 불가
+        }
+        if (count_masks_[3]) return HandRank::FourOfKind;
+        if (count_masks_[2] && std::popcount(count_masks_[1]) >= 2) return HandRank::FullHouse;
+        if (straight_mask()) return HandRank::Straight;
+        if (count_masks_[2]) return HandRank::ThreeOfKind;
+        if (std::popcount(count_masks_[1]) >= 2) return HandRank::TwoPair;
+        if (count_masks_[1]) return HandRank::OnePair;
+        return HandRank::TopCard;
+    }
+
+    /*
+    현재 세기를 정수 하나로: 족보 << 26 | 주 랭크 마스크 << 13 | 키커 마스크
+    같은 개수의 랭크 마스크는 숫자 비교가 곧 높은 랭크부터의 사전식 비교이므로
+    value() 와 순서가 완전히 같다 (휠 스트레이트가 K 하이보다 높은 것까지).
+    HandValue 를 만들지 않으므로 비교만 필요한 열거 루프에서 쓴다.
+    */
+    constexpr std::uint32_t strength() const {
+        auto key = [](HandRank rank, std::uint32_t major, std::uint32_t kickers = 0) {
+            return (static_cast<std::uint32_t>(rank) << 26) | (major << 13) | kickers;
+        };
+
+        for (size_t s = 0; s < 4; ++s) {
+            if (suit_counts_[s] < 5) continue;
+            if (auto sf = detail::STRAIGHT_TABLE[suits_[s]]) {
+                return key((sf & (1u << 12)) ? HandRank::RoyalFlush : HandRank::StraightFlush, sf);
+            }
+            return key(HandRank::Flush, top_ranks(suits_[s], 5));
+        }
+
+        const auto any = count_masks_[0];
+        const auto pairs = count_masks_[1];   // 2장 이상
+        const auto trips = count_masks_[2];   // 3장 이상
+
+        if (auto quads = count_masks_[3]) {
+            auto q = top_ranks(quads, 1);
+            return key(HandRank::FourOfKind, q, top_ranks(any & ~q, 1));
+        }
+        if (trips) {
+            auto t = top_ranks(trips, 1);
+            if (auto rest = pairs & ~t) return key(HandRank::FullHouse, t, top_ranks(rest, 1));
+        }
+        if (auto st = straight_mask()) return key(HandRank::Straight, st);
+        if (trips) {
+            auto t = top_ranks(trips, 1);
+            return key(HandRank::ThreeOfKind, t, top_ranks(any & ~t, 2));
+        }
+        if (std::popcount(pairs) >= 2) {
+            auto p = top_ranks(pairs, 2);
+            return key(HandRank::TwoPair, p, top_ranks(any & ~p, 1));
+        }
+        if (pairs) return key(HandRank::OnePair, pairs, top_ranks(any & ~pairs, 3));
+        return key(HandRank::TopCard, top_ranks(any, 5));
+    }
+
+    // 타이브레이커까지 포함한 값
+    constexpr HandValue value() const { return detail::evaluate_masks(suits_); }
+
+private:
+    CardSet cards_{};
+    std::array<std::uint16_t, 4> suits_{};       // 수트별 랭크 마스크
+    std::array<std::uint16_t, 4> count_masks_{}; // [k] = k+1 장 이상 있는 랭크
+    std::array<std::uint8_t, 13> rank_counts_{};
+    std::array<std::uint8_t, 4> suit_counts_{};
+    std::uint8_t size_{0};
+
+    // 마스크에서 높은 랭크 count 개만 남긴다
+    static constexpr std::uint32_t top_ranks(std::uint32_t mask, int count) {
+        while (std::popcount(mask) > count) mask &= mask - 1;
+        return mask;
+    }
+};
+
+constexpr std::strong_ordering compare(const IncrementalHand& a, const IncrementalHand& b) {
+    return a.strength() <=> b.strength();
+}
+
+} // namespace poker
@@ -0,0 +1,229 @@
+#pragma once
+
+#include "game.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace poker {
+
+struct MatchupOptions {
+    size_t small_blind{10};
+    size_t stack{2000};                 // 매 핸드 시작 스택 (캐시 게임처럼 리필)
+    std::uint64_t min_blocks{200};      // SPRT 판정 전 최소 블록 수
+    std::uint64_t max_blocks{50'000};   // 판정이 안 나도 여기서 멈춘다
+    std::uint64_t batch{256};           // 병렬로 돌린 뒤 SPRT 를 확인하는 단위
+    double delta_bb{0.1};               // SPRT 효과 크기 (핸드당 bb)
+    double alpha{0.05};
+    double beta{0.05};
+    unsigned threads{0};
+    std::uint32_t seed{0};              // 0 = random_device
+};
+
+enum class SprtVerdict {
+    Better,         // 후보(0번 전략)가 +delta_bb 쪽
+    Worse,          // 후보가 -delta_bb 쪽
+    Inconclusive    // max_blocks 까지 판정 불가
+};
+
+struct StrategyResult {
+    std::string name;
+    double bb_per_100{0.0};
+    double ci95{0.0};           // bb/100 의 95% 신뢰구간 반폭
+};
+
+struct MatchupResult {
+    std::vector<StrategyResult> strategies;
+    std::uint64_t blocks{0};
+    std::uint64_t hands{0};
+    double llr{0.0};
+    SprtVerdict verdict{SprtVerdict::Inconclusive};
+};
+
+// 온라인 평균/분산 (Welford). 샤드끼리는 merge 로 합친다 (Chan 공식)
+struct RunningStats {
+    std::uint64_t n{0};
+    double mean{0.0};
+    double m2{0.0};
+
+    void add(double x) {
+        ++n;
+        double d = x - mean;
+        mean += d / static_cast<double>(n);
+        m2 += d * (x - mean);
+    }
+
+    void merge(const RunningStats& other) {
+        if (other.n == 0) return;
+        if (n == 0) { *this = other; return; }
+        const double total = static_cast<double>(n + other.n);
+        const double d = other.mean - mean;
+        mean += d * static_cast<double>(other.n) / total;
+        m2 += other.m2 + d * d * static_cast<double>(n) * static_cast<double>(other.n) / total;
+        n += other.n;
+    }
+
+    double variance() const {
+        return n > 1 ? m2 / static_cast<double>(n - 1) : 0.0;
+    }
+};
+
+/*
+전략 대 전략 매치업
+
+블록 = 같은 시드로 섞은 덱을 좌석만 돌려가며 N번 플레이 (N = 전략 수)
+모든 전략이 같은 카드/같은 포지션을 한 번씩 받으므로 카드 운이 상쇄된다 (미러 딜).
+
+    Matchup<SmartAI, AggressiveAI> matchup{{"Smart", "Aggressive"}};
+    auto result = matchup.run();
+
+0번 전략을 후보로 보고 블록 평균(핸드당 bb)에 대해
+H0: mu = -delta, H1: mu = +delta 인 SPRT 를 돌려 판정이 나면 바로 멈춘다.
+
+여러 프로세스로 나눌 때는 play_blocks 로 블록 범위마다 통계를 내고, 합친 통계를
+summarize 에 넘긴다 (이때는 고정 표본이라 SPRT 는 끝에서 한 번만 본다).
+*/
+template<typename... Strategies>
+class Matchup {
+public:
+    static constexpr size_t SEATS = sizeof...(Strategies);
+    static_assert(SEATS >= 2, "Matchup needs at least two strategies");
+
+    explicit Matchup(std::array<std::string, SEATS> names, MatchupOptions options = {})
+        : names_(std::move(names)), options_(options)
+    {}
+
+    MatchupResult run() const {
+        std::uint32_t seed = options_.seed ? options_.seed : std::random_device{}();
+        const double upper = std::log((1.0 - options_.beta) / options_.alpha);
+        const double lower = std::log(options_.beta / (1.0 - options_.alpha));
+
+        std::array<RunningStats, SEATS> stats{};
+        std::vector<std::array<double, SEATS>> batch(options_.batch);
+        MatchupResult result;
+
+        while (result.blocks < options_.max_blocks) {
+            size_t count = static_cast<size_t>(
+                std::min<std::uint64_t>(options_.batch, options_.max_blocks - result.blocks));
+            play_batch(seed, result.blocks, count, batch, stats);
+            result.blocks += count;
+
+            if (result.blocks >= options_.min_blocks) {
+                result.llr = llr(stats[0]);
+                if (result.llr >= upper) { result.verdict = SprtVerdict::Better; break; }
+                if (result.llr <= lower) { result.verdict = SprtVerdict::Worse; break; }
+            }
+        }
+
+        finish(stats, result);
+        return result;
+    }
+
+    // 블록 [first, first + count) 를 SPRT 없이 (샤드 워커용, seed 는 모든 샤드가 같아야 한다)
+    std::array<RunningStats, SEATS> play_blocks(std::uint32_t seed, std::uint64_t first, std::uint64_t count) const {
+        std::array<RunningStats, SEATS> stats{};
+        std::vector<std::array<double, SEATS>> batch(options_.batch);
+        for (std::uint64_t done = 0; done < count;) {
+            size_t n = static_cast<size_t>(std::min<std::uint64_t>(options_.batch, count - done));
+            play_batch(seed, first + done, n, batch, stats);
+            done += n;
+        }
+        return stats;
+    }
+
+    // 합친 샤드 통계 → 결과. 판정은 최종 LLR 이 경계를 넘었는지만 본다
+    MatchupResult summarize(const std::array<RunningStats, SEATS>& stats) const {
+        MatchupResult result;
+        result.blocks = stats[0].n;
+        result.llr = llr(stats[0]);
+        if (result.llr >= std::log((1.0 - options_.beta) / options_.alpha)) result.verdict = SprtVerdict::Better;
+        else if (result.llr <= std::log(options_.beta / (1.0 - options_.alpha))) result.verdict = SprtVerdict::Worse;
+        finish(stats, result);
+        return result;
+    }
+
+private:
+    std::array<std::string, SEATS> names_;
+    MatchupOptions options_;
+
+    // 블록 [first, first + count) 를 병렬로 돌리고 블록 순서대로 합친다
+    // 딜과 전략 난수가 모두 블록 시드에서 나오므로 스레드 수와 무관하게 같은 결과
+    // (seed() 가 없는 전략이 난수를 쓰거나, MctsAI 처럼 시간 한도로 멈추면 예외)
+    void play_batch(std::uint32_t seed, std::uint64_t first, size_t count,
+                    std::vector<std::array<double, SEATS>>& batch, std::array<RunningStats, SEATS>& stats) const {
+        parallel_for(count, options_.threads, [&](size_t i, unsigned) {
+            batch[i] = play_block(seed + static_cast<std::uint32_t>(first + i));
+        });
+        for (size_t i = 0; i < count; ++i) {
+            for (size_t s = 0; s < SEATS; ++s) stats[s].add(batch[i][s]);
+        }
+    }
+
+    // 정규 근사 SPRT: LLR = 2 * delta * sum(x) / var
+    double llr(const RunningStats& candidate) const {
+        double var = candidate.variance();
+        if (var <= 0.0) return 0.0;
+        return 2.0 * options_.delta_bb * candidate.mean * static_cast<double>(candidate.n) / var;
+    }
+
+    void finish(const std::array<RunningStats, SEATS>& stats, MatchupResult& result) const {
+        result.hands = result.blocks * SEATS;
+        for (size_t s = 0; s < SEATS; ++s) {
+            const auto& w = stats[s];
+            double se = w.n > 1 ? std::sqrt(w.variance() / static_cast<double>(w.n)) : 0.0;
+            result.strategies.push_back(StrategyResult{names_[s], w.mean * 100.0, 1.96 * se * 100.0});
+        }
+    }
+
+    // 블록 하나: 좌석을 돌려가며 같은 딜을 SEATS 번. 전략별 핸드당 평균 bb
+    std::array<double, SEATS> play_block(std::uint32_t seed) const {
+        std::array<double, SEATS> result{};
+        std::tuple<Strategies...> strategies;
+        const double bb = static_cast<double>(options_.small_blind * 2);
+
+        for (size_t rotation = 0; rotation < SEATS; ++rotation) {
+            Game game(options_.small_blind, nullptr);
+            game.seed(seed);
+            // 로테이션마다 다시 시드해서 같은 딜에서는 좌석이 바뀌어도 전략마다 같은 난수를 받는다
+            seed_strategies(strategies, seed);
+
+            std::vector<Player<5>> players;
+            players.reserve(SEATS);
+            std::array<size_t, SEATS> owner{};  // 좌석 → 전략 번호
+
+            for (size_t seat = 0; seat < SEATS; ++seat) {
+                owner[seat] = (seat + rotation) % SEATS;
+                players.emplace_back(std::string{names_[owner[seat]]}, options_.stack);
+                seat_strategy(game, &players.back(), strategies, owner[seat],
+                              std::index_sequence_for<Strategies...>{});
+            }
+
+            game.start_round();
+
+            for (size_t seat = 0; seat < SEATS; ++seat) {
+                double delta = static_cast<double>(players[seat].chips()) -
+                               static_cast<double>(options_.stack);
+                result[owner[seat]] += delta / bb;
+            }
+        }
+
+        for (auto& r : result) r /= static_cast<double>(SEATS);
+        return result;
+    }
+
+    // 런타임 번호 → tuple 의 전략 (Fold Expression)
+    template<size_t... Is>
+    static void seat_strategy(Game& game, Player<5>* player, std::tuple<Strategies...>& strategies,
+                              size_t index, std::index_sequence<Is...>) {
+        ((index == Is ? game.add_player(player, std::get<Is>(strategies)) : void()), ...);
+    }
+};
+
+} // namespace poker
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "card_set.hpp"
+#include "hand.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+namespace poker {
+
+/*
+저장/해싱용 압축 표현
+
+    Card (2바이트)        → PackedCard (1바이트, 6비트 인덱스)
+    Hand<5> (10바이트)    → PackedHand (4바이트, 5장 조합 번호 0 ~ C(52,5)-1)
+                          → CardSet (8바이트, 52비트 집합)
+    HandValue (6바이트)   → HandValue::packed() (4바이트, 순서 보존)
+
+Card/Hand 의 비교는 랭크만 보지만 압축 표현은 카드 자체를 구분한다
+(같은 랭크 다른 수트는 다른 값).
+*/
+struct PackedCard {
+    std::uint8_t index{0};  // card_index(): suit * 13 + (rank - 2)
+
+    constexpr PackedCard() = default;
+    constexpr explicit PackedCard(const Card& card)
+        : index(static_cast<std::uint8_t>(card_index(card)))
+    {}
+
+    constexpr Card card() const { return card_at(index); }
+
+    constexpr auto operator<=>(const PackedCard&) const = default;
+};
+static_assert(sizeof(PackedCard) == 1);
+
+namespace detail {
+
+    // BINOMIAL[n][k] = C(n, k), n <= 52, k <= 7
+    inline constexpr auto BINOMIAL = [] {
+        std::array<std::array<std::uint32_t, 8>, 53> table{};
+        for (size_t n = 0; n < table.size(); ++n) {
+            table[n][0] = 1;
+            for (size_t k = 1; k < 8 && k <= n; ++k) {
+                table[n][k] = table[n - 1][k - 1] + table[n - 1][k];
+            }
+        }
+        return table;
+    }();
+
+} // namespace detail
+
+// k장 집합(k <= 7)의 조합 번호 (colex): 카드 인덱스 c1 < c2 < ... 에 대해 sum C(ci, i)
+constexpr std::uint32_t combination_index(CardSet cards) {
+    if (cards.size() > 7) throw std::out_of_range("combination_index supports up to 7 cards");
+    std::uint32_t index = 0;
+    size_t k = 1;
+    for (std::uint64_t b = cards.bits(); b; b &= b - 1) {
+        index += detail::BINOMIAL[static_cast<size_t>(std::countr_zero(b))][k++];
+    }
+    return index;
+}
+
+// combination_index 의 역함수
+constexpr CardSet combination_at(size_t k, std::uint32_t index) {
+    if (k > 7) throw std::out_of_range("combination_at supports up to 7 cards");
+    if (index >= detail::BINOMIAL[52][k]) throw std::out_of_range("Combination index out of range");
+    CardSet cards;
+    int c = 52;
+    for (; k > 0; --k) {
+        // C(c, k) <= index 인 가장 큰 c
+        do { --c; } while (detail::BINOMIAL[static_cast<size_t>(c)][k] > index);
+        cards.insert_index(c);
+        index -= detail::BINOMIAL[static_cast<size_t>(c)][k];
+    }
+    return cards;
+}
+
+// 5장 핸드 = 조합 번호 하나 (2,598,960 가지 → 22비트)
+struct PackedHand {
+    static constexpr std::uint32_t COUNT = detail::BINOMIAL[52][5];
+
+    std::uint32_t index{0};
+
+    constexpr PackedHand() = default;
+    constexpr explicit PackedHand(CardSet cards) : index(check(cards)) {}
+    explicit PackedHand(const Hand<5>& hand) : PackedHand(CardSet{hand}) {}
+
+    constexpr CardSet cards() const { return combination_at(5, index); }
+    Hand<5> hand() const { return make_hand<5>(cards()); }
+
+    constexpr auto operator<=>(const PackedHand&) const = default;
+
+private:
+    static constexpr std::uint32_t check(CardSet cards) {
+        if (cards.size() != 5) throw std::invalid_argument("PackedHand needs exactly 5 distinct cards");
+        return combination_index(cards);
+    }
+};
+static_assert(sizeof(PackedHand) == 4);
+
+} // namespace poker
+
+// 해시는 압축 값을 그대로 쓴다 (CardSet, HandValue 는 각자 헤더에)
+template<>
+struct std::hash<poker::PackedCard> {
+    size_t operator()(const poker::PackedCard& c) const noexcept { return c.index; }
+};
+
+template<>
+struct std::hash<poker::PackedHand> {
+    size_t operator()(const poker::PackedHand& h) const noexcept { return h.index; }
+};
@@ -0,0 +1,164 @@
+#pragma once
+
+#include "trace.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace poker {
+
+inline unsigned default_thread_count() {
+    unsigned n = std::thread::hardware_concurrency();
+    return n ? n : 1;
+}
+
+// [0, tasks) 작업을 threads 개 워커가 나눠 처리한다. fn(task, worker)
+// 작업 크기가 제각각이어도 놀고 있는 워커가 없도록 원자 카운터로 하나씩 가져간다.
+template<typename F>
+void parallel_for(size_t tasks, unsigned threads, F&& fn) {
+    if (threads == 0) threads = default_thread_count();
+    threads = static_cast<unsigned>(std::min<size_t>(threads, tasks));
+
+    if (threads <= 1) {
+        for (size_t i = 0; i < tasks; ++i) {
+            TraceSpan span("task", "pool");
+            fn(i, 0u);
+        }
+        return;
+    }
+
+    std::atomic<size_t> next{0};
+    std::vector<std::jthread> workers;
+    workers.reserve(threads);
+    for (unsigned w = 0; w < threads; ++w) {
+        workers.emplace_back([&, w] {
+            // worker 구간과 task 구간의 차이가 일감이 떨어져 노는 시간
+            TraceSpan worker_span("worker", "pool");
+            for (size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < tasks;) {
+                TraceSpan span("task", "pool");
+                fn(i, w);
+            }
+        });
+    }
+}
+
+/*
+스레드를 한 번 띄워 두고 계속 쓰는 워커 풀
+
+    WorkerPool pool(4);
+    for (...) pool.run(tasks, [&](size_t task, unsigned worker) { ... });   // parallel_for 와 같은 규칙
+
+run 을 부른 스레드가 워커 0 으로 같이 일하고, 나머지 size() - 1 개는 풀이 살아 있는 동안
+다음 run 을 기다린다. 토너먼트 단계나 MCTS decide 처럼 짧은 일을 자주 나눌 때
+매번 스레드를 만들고 join 하는 비용이 없고, 스레드별 TraceBuffer 도 풀 크기만큼만 생긴다.
+run 은 한 번에 한 스레드에서만 부른다. 작업이 던진 첫 예외는 모든 워커가 멈춘 뒤 run 이 다시 던진다.
+*/
+class WorkerPool {
+public:
+    explicit WorkerPool(unsigned threads = 0) {
+        if (threads == 0) threads = default_thread_count();
+        helpers_.reserve(threads - 1);
+        for (unsigned w = 1; w < threads; ++w) {
+            helpers_.emplace_back([this, w] { serve(w); });
+        }
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned size() const { return static_cast<unsigned>(helpers_.size()) + 1; }
+
+    // [0, tasks) 를 풀의 워커가 나눠 처리한다. fn(task, worker), worker < size()
+    template<typename F>
+    void run(size_t tasks, F&& fn) {
+        using Fn = std::remove_reference_t<F>;
+        if (helpers_.empty() || tasks <= 1) {
+            for (size_t i = 0; i < tasks; ++i) {
+                TraceSpan span("task", "pool");
+                fn(i, 0u);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard lock(mutex_);
+            job_ = Job{const_cast<void*>(static_cast<const void*>(&fn)),
+                       [](void* f, size_t i, unsigned w) { (*static_cast<Fn*>(f))(i, w); }, tasks};
+            next_.store(0, std::memory_order_relaxed);
+            pending_ = helpers_.size();
+            error_ = nullptr;
+            ++generation_;
+        }
+        wake_.notify_all();
+        work(0);
+
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [&] { return pending_ == 0; });
+        if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+    }
+
+private:
+    struct Job {
+        void* fn{nullptr};
+        void (*call)(void*, size_t, unsigned){nullptr};
+        size_t tasks{0};
+    };
+
+    std::mutex mutex_;
+    std::condition_variable wake_;      // 새 run 또는 종료
+    std::condition_variable done_;      // 도우미가 모두 이번 run 을 끝냈다
+    Job job_;
+    std::atomic<size_t> next_{0};
+    size_t pending_{0};                 // 이번 run 을 아직 안 끝낸 도우미 수
+    std::uint64_t generation_{0};
+    bool stopping_{false};
+    std::exception_ptr error_;
+    std::vector<std::jthread> helpers_; // 마지막에 둬서 다른 멤버보다 먼저 join 된다
+
+    void work(unsigned w) {
+        // worker 구간과 task 구간의 차이가 일감이 떨어져 노는 시간
+        TraceSpan worker_span("worker", "pool");
+        try {
+            for (size_t i; (i = next_.fetch_add(1, std::memory_order_relaxed)) < job_.tasks;) {
+                TraceSpan span("task", "pool");
+                job_.call(job_.fn, i, w);
+            }
+        } catch (...) {
+            next_.store(job_.tasks, std::memory_order_relaxed);    // 남은 작업은 버린다
+            std::lock_guard lock(mutex_);
+            if (!error_) error_ = std::current_exception();
+        }
+    }
+
+    void serve(unsigned w) {
+        std::uint64_t seen = 0;
+        std::unique_lock lock(mutex_);
+        for (;;) {
+            wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+            if (stopping_) return;
+            seen = generation_;
+            lock.unlock();
+            work(w);
+            lock.lock();
+            if (--pending_ == 0) done_.notify_one();
+        }
+    }
+};
+
+} // namespace poker
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "card_set.hpp"
+#include "evaluator.hpp"
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+namespace poker {
+
+struct WeightedCombo {
+    CardSet cards;
+    double weight{1.0};
+};
+
+/*
+레인지: 가중치가 붙은 핸드 조합 목록
+
+- 5카드 드로우(Hand<5>): add_category() 로 족보별 가중치를 준다
+- 홀덤 홀카드: add_starting_hand("AKs") 또는 Range::parse("AA, KK, AKs")
+*/
+class Range {
+public:
+    Range() = default;
+
+    void add(CardSet combo, double weight = 1.0) {
+        if (weight > 0.0) combos_.push_back(WeightedCombo{combo, weight});
+    }
+
+    template<size_t N>
+    void add(const Hand<N>& hand, double weight = 1.0) {
+        add(CardSet{hand}, weight);
+    }
+
+    // 해당 족보에 속하는 모든 5장 조합 (C(52,5) 전수)
+    void add_category(HandRank category, double weight = 1.0) {
+        for (int a = 0; a < 52; ++a)
+        for (int b = a + 1; b < 52; ++b)
+        for (int c = b + 1; c < 52; ++c)
+        for (int d = c + 1; d < 52; ++d)
+        for (int e = d + 1; e < 52; ++e) {
+            CardSet set;
+            set.insert_index(a); set.insert_index(b); set.insert_index(c);
+            set.insert_index(d); set.insert_index(e);
+            if (evaluate(set).rank == category) add(set, weight);
+        }
+    }
+
+    // 홀덤 스타팅 핸드 표기: "AA"(6콤보), "AKs"(4), "AKo"(12), "AK"(16)
+    void add_starting_hand(std::string_view notation, double weight = 1.0) {
+        if (notation.size() < 2 || notation.size() > 3) {
+            throw std::invalid_argument("Invalid starting hand notation");
+        }
+        int hi = parse_rank(notation[0]);
+        int lo = parse_rank(notation[1]);
+        char kind = notation.size() == 3 ? notation[2] : '\0';
+        if (kind != '\0' && kind != 's' && kind != 'o') {
+            throw std::invalid_argument("Invalid starting hand notation");
+        }
+        if (hi == lo && kind != '\0') {
+            throw std::invalid_argument("Pocket pairs cannot be suited or offsuit");
+        }
+
+        for (int s1 = 0; s1 < 4; ++s1) {
+            for (int s2 = 0; s2 < 4; ++s2) {
+                if (hi == lo && s2 <= s1) continue;
+                if (kind == 's' && s1 != s2) continue;
+                if (kind == 'o' && s1 == s2) continue;
+                CardSet combo;
+                combo.insert_index(s1 * 13 + hi);
+                combo.insert_index(s2 * 13 + lo);
+                add(combo, weight);
+            }
+        }
+    }
+
+    // 쉼표로 구분된 스타팅 핸드 목록
+    static Range parse(std::string_view text, double weight = 1.0) {
+        Range range;
+        while (!text.empty()) {
+            auto comma = text.find(',');
+            auto token = trim(text.substr(0, comma));
+            if (!token.empty()) range.add_starting_hand(token, weight);
+            if (comma == std::string_view::npos) break;
+            text.remove_prefix(comma + 1);
+        }
+        return range;
+    }
+
+    // dead 카드와 겹치는 조합 제거
+    Range without(CardSet dead) const {
+        Range result;
+        for (auto& combo : combos_) {
+            if (!combo.cards.intersects(dead)) result.combos_.push_back(combo);
+        }
+        return result;
+    }
+
+    const std::vector<WeightedCombo>& combos() const { return combos_; }
+    size_t size() const { return combos_.size(); }
+    bool empty() const { return combos_.empty(); }
+
+    double total_weight() const {
+        double sum = 0.0;
+        for (auto& combo : combos_) sum += combo.weight;
+        return sum;
+    }
+
+private:
+    std::vector<WeightedCombo> combos_;
+
+    // '2'~'9', 'T', 'J', 'Q', 'K', 'A' → 0~12
+    static int parse_rank(char c) {
+        switch (c) {
+            case 'T': case 't': return 8;
+            case 'J': case 'j': return 9;
+            case 'Q': case 'q': return 10;
+            case 'K': case 'k': return 11;
+            case 'A': case 'a': return 12;
+            default:
+                if (c >= '2' && c <= '9') return c - '2';
+                throw std::invalid_argument("Invalid rank character");
+        }
+    }
+
+    static std::string_view trim(std::string_view s) {
+        while (!s.empty() && s.front() == ' ') s.remove_prefix(1);
+        while (!s.empty() && s.back() == ' ') s.remove_suffix(1);
+        return s;
+    }
+};
+
+} // namespace poker
@@ -0,0 +1,287 @@
+#pragma once
+
+#include "checkpoint.hpp"
+#include "equity.hpp"
+#include "matchup.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+#define POKER_SHARD_PROCESSES 1
+#else
+#define POKER_SHARD_PROCESSES 0
+#endif
+
+namespace poker {
+
+namespace detail {
+
+    inline constexpr std::array<char, 8> SHARD_MAGIC{'P', 'K', 'R', 'S', 'H', 'R', 'D', '1'};
+
+} // namespace detail
+
+// 작업 단위 범위 하나 [first, first + units) (매치업 블록 / 에퀴티 표본 묶음)
+struct Shard {
+    std::uint32_t index{0};
+    std::uint32_t count{1};
+    std::uint64_t first{0};
+    std::uint64_t units{0};
+};
+
+// units 개를 shards 개로 앞에서부터 고르게 나눈다 (앞쪽 샤드가 최대 1개 더)
+inline std::vector<Shard> split_shards(std::uint64_t units, std::uint32_t shards) {
+    if (shards == 0) throw std::invalid_argument("Need at least one shard");
+    std::vector<Shard> result;
+    std::uint64_t first = 0;
+    for (std::uint32_t i = 0; i < shards; ++i) {
+        std::uint64_t size = units / shards + (i < units % shards);
+        result.push_back(Shard{i, shards, first, size});
+        first += size;
+    }
+    return result;
+}
+
+enum class ShardJob : std::uint32_t {
+    Matchup = 1,    // values = 전략별 (n, mean, m2)
+    Equity = 2      // values = (win, tie, lose, samples), 비율이 아니라 표본 수 단위
+};
+
+// 워커 하나가 파일 하나로 남기는 결과
+struct ShardResult {
+    ShardJob job{ShardJob::Matchup};
+    std::uint64_t job_key{0};       // 작업 설정 지문. 다른 작업의 파일이 섞이면 merge 가 거부한다
+    Shard shard{};
+    std::vector<double> values;
+};
+
+// 설정 문자열 → 지문 (코디네이터와 워커가 같은 문자열을 만들면 같은 값)
+inline std::uint64_t shard_job_key(std::string_view description) {
+    return detail::fnv1a(reinterpret_cast<const std::byte*>(description.data()), description.size());
+}
+
+inline std::string shard_file_name(const Shard& shard) {
+    return "shard-" + std::to_string(shard.index) + "-of-" + std::to_string(shard.count) + ".bin";
+}
+
+/*
+샤드 결과 파일 = 매직 + CheckpointWriter 본문 + FNV-1a 체크섬 (고정폭, 이 머신의 바이트 순서)
+임시 파일에 다 쓴 뒤 rename 으로 공개하므로 다른 머신이 공유 디렉터리를 읽어도 반쯤 쓴 파일은 안 보인다.
+*/
+inline void write_shard_result(const std::filesystem::path& path, const ShardResult& result) {
+    CheckpointWriter out;
+    out.put(detail::SHARD_MAGIC);
+    out.put(result.job);
+    out.put(result.job_key);
+    out.put(result.shard);
+    out.put(result.values);
+    const auto body = out.bytes();
+    const auto sum = detail::fnv1a(body.data(), body.size());
+
+    auto temporary = path;
+    temporary += ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+        file.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+        if (!file) throw std::runtime_error("Cannot write shard result " + temporary.string());
+    }
+    std::filesystem::rename(temporary, path);
+}
+
+inline ShardResult read_shard_result(const std::filesystem::path& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) throw std::runtime_error("Cannot open shard result " + path.string());
+    std::vector<char> raw{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+    std::uint64_t sum = 0;
+    if (raw.size() < sizeof(sum)) throw std::runtime_error("Shard result is truncated: " + path.string());
+    const size_t body_size = raw.size() - sizeof(sum);
+    std::memcpy(&sum, raw.data() + body_size, sizeof(sum));
+    std::span<const std::byte> body{reinterpret_cast<const std::byte*>(raw.data()), body_size};
+    if (detail::fnv1a(body.data(), body.size()) != sum) {
+        throw std::runtime_error("Shard result checksum mismatch: " + path.string());
+    }
+
+    CheckpointReader in(body);
+    if (in.get<std::array<char, 8>>() != detail::SHARD_MAGIC) throw std::runtime_error("Not a shard result: " + path.string());
+    ShardResult result;
+    result.job = in.get<ShardJob>();
+    result.job_key = in.get<std::uint64_t>();
+    result.shard = in.get<Shard>();
+    result.values = in.get_vector<double>();
+    if (!in.done()) throw std::runtime_error("Shard result has trailing data: " + path.string());
+    return result;
+}
+
+// 매치업 통계 ↔ values
+template<size_t SEATS>
+std::vector<double> pack_stats(const std::array<RunningStats, SEATS>& stats) {
+    std::vector<double> values;
+    for (const auto& s : stats) values.insert(values.end(), {static_cast<double>(s.n), s.mean, s.m2});
+    return values;
+}
+
+template<size_t SEATS>
+std::array<RunningStats, SEATS> unpack_stats(const std::vector<double>& values) {
+    if (values.size() != 3 * SEATS) throw std::invalid_argument("Shard values do not match the seat count");
+    std::array<RunningStats, SEATS> stats{};
+    for (size_t s = 0; s < SEATS; ++s) {
+        stats[s] = RunningStats{static_cast<std::uint64_t>(values[3 * s]), values[3 * s + 1], values[3 * s + 2]};
+    }
+    return stats;
+}
+
+// 에퀴티 결과 ↔ values (합칠 수 있게 표본 수 단위로)
+inline std::vector<double> pack_equity(const EquityResult& r) {
+    const auto n = static_cast<double>(r.samples);
+    return {r.win * n, r.tie * n, r.lose * n, n};
+}
+
+inline EquityResult unpack_equity(const std::vector<double>& values) {
+    if (values.size() != 4) throw std::invalid_argument("Shard values are not an equity result");
+    EquityResult r;
+    const double total = values[0] + values[1] + values[2];
+    if (total > 0.0) {
+        r.win = values[0] / total;
+        r.tie = values[1] / total;
+        r.lose = values[2] / total;
+    }
+    r.samples = static_cast<std::uint64_t>(values[3]);
+    return r;
+}
+
+/*
+샤드 결과 합치기. 샤드 번호 순서로 합쳐서 파일을 읽은 순서, 워커가 끝난 순서와 무관하게 같은 값
+모든 샤드가 같은 작업(job, job_key, 샤드 수) 이고 0..count-1 이 빠짐없이 이어져 있어야 한다.
+*/
+inline std::vector<double> merge_shard_results(std::vector<ShardResult> results) {
+    if (results.empty()) throw std::invalid_argument("No shard results to merge");
+    std::sort(results.begin(), results.end(), [](const auto& a, const auto& b) { return a.shard.index < b.shard.index; });
+
+    const auto& head = results.front();
+    if (results.size() != head.shard.count) {
+        throw std::invalid_argument("Expected " + std::to_string(head.shard.count) + " shard results, found " +
+                                    std::to_string(results.size()));
+    }
+    std::uint64_t next = 0;
+    for (size_t i = 0; i < results.size(); ++i) {
+        const auto& r = results[i];
+        if (r.job != head.job || r.job_key != head.job_key || r.shard.count != head.shard.count) {
+            throw std::invalid_argument("Shard results come from different jobs");
+        }
+        if (r.shard.index != i || r.shard.first != next || r.values.size() != head.values.size()) {
+            throw std::invalid_argument("Shard " + std::to_string(i) + " is missing or does not line up");
+        }
+        next += r.shard.units;
+    }
+
+    std::vector<double> merged = head.values;
+    if (head.job == ShardJob::Matchup) {
+        if (merged.size() % 3 != 0) throw std::invalid_argument("Matchup shard values must be (n, mean, m2) triples");
+        for (size_t i = 1; i < results.size(); ++i) {
+            for (size_t s = 0; s < merged.size(); s += 3) {
+                RunningStats a{static_cast<std::uint64_t>(merged[s]), merged[s + 1], merged[s + 2]};
+                const auto& v = results[i].values;
+                a.merge(RunningStats{static_cast<std::uint64_t>(v[s]), v[s + 1], v[s + 2]});
+                merged[s] = static_cast<double>(a.n);
+                merged[s + 1] = a.mean;
+                merged[s + 2] = a.m2;
+            }
+        }
+    } else {
+        for (size_t i = 1; i < results.size(); ++i) {
+            for (size_t k = 0; k < merged.size(); ++k) merged[k] += results[i].values[k];
+        }
+    }
+    return merged;
+}
+
+// 디렉터리의 shard-*-of-count.bin 을 모두 읽어서 합친다
+inline std::vector<double> merge_shard_directory(const std::filesystem::path& dir, std::uint32_t count) {
+    std::vector<ShardResult> results;
+    for (std::uint32_t i = 0; i < count; ++i) {
+        results.push_back(read_shard_result(dir / shard_file_name(Shard{i, count, 0, 0})));
+    }
+    return merge_shard_results(std::move(results));
+}
+
+/*
+워커 프로세스 실행 (POSIX). commands[i] 마다 프로세스 하나를 fork/exec 하고, pin 이면
+이 프로세스가 쓸 수 있는 CPU 중 i 번째(나머지) 에 고정한 뒤 모두 끝날 때까지 기다린다.
+반환값은 실패한 (종료 코드가 0이 아니거나 시그널로 죽은) 워커 번호들.
+CPU 고정은 Linux 에서만 하고, 다른 POSIX 에서는 그냥 띄운다.
+*/
+inline std::vector<size_t> run_worker_processes(const std::vector<std::vector<std::string>>& commands, bool pin = true) {
+#if POKER_SHARD_PROCESSES
+#if defined(__linux__)
+    std::vector<int> cpus;
+    cpu_set_t allowed;
+    CPU_ZERO(&allowed);
+    if (pin && ::sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &allowed)) cpus.push_back(c);
+        }
+    }
+#endif
+
+    std::vector<pid_t> pids;
+    std::vector<size_t> failed;
+    for (size_t i = 0; i < commands.size(); ++i) {
+        // exec 전에 argv 를 만들어 둔다 (fork 후 자식에서는 할당하지 않는다)
+        std::vector<char*> argv;
+        for (const auto& arg : commands[i]) argv.push_back(const_cast<char*>(arg.c_str()));
+        argv.push_back(nullptr);
+
+        pid_t pid = ::fork();
+        if (pid < 0) {
+            failed.push_back(i);
+            continue;
+        }
+        if (pid == 0) {
+#if defined(__linux__)
+            if (!cpus.empty()) {
+                cpu_set_t one;
+                CPU_ZERO(&one);
+                CPU_SET(cpus[i % cpus.size()], &one);
+                ::sched_setaffinity(0, sizeof(one), &one);
+            }
+#endif
+            ::execv(argv[0], argv.data());
+            ::_exit(127);
+        }
+        pids.push_back(pid);
+    }
+
+    for (size_t i = 0, p = 0; i < commands.size(); ++i) {
+        if (std::find(failed.begin(), failed.end(), i) != failed.end()) continue;
+        int status = 0;
+        if (::waitpid(pids[p++], &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+            failed.push_back(i);
+        }
+    }
+    std::sort(failed.begin(), failed.end());
+    return failed;
+#else
+    (void)commands;
+    (void)pin;
+    throw std::runtime_error("Worker processes need a POSIX platform");
+#endif
+}
+
+} // namespace poker
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "action.hpp"
+#include "hand.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace poker {
+
+// 한 플레이어 통계의 스냅샷 (일반 값)
+struct OpponentProfile {
+    std::uint64_t hands{0};
+    std::uint64_t vpip{0};              // 자발적으로 팟에 돈을 넣은 핸드 (블라인드 제외)
+    std::uint64_t aggressive{0};        // 벳/레이즈/올인
+    std::uint64_t passive{0};           // 콜/체크/폴드
+    std::uint64_t faced_raise{0};       // 레이즈를 마주한 횟수
+    std::uint64_t folded_to_raise{0};
+    std::uint64_t showdowns{0};
+    std::uint64_t showdown_rank_sum{0}; // 쇼다운 HandRank 합
+
+    double vpip_rate() const { return ratio(vpip, hands); }
+    double aggression_frequency() const { return ratio(aggressive, aggressive + passive); }
+    double fold_to_raise() const { return ratio(folded_to_raise, faced_raise); }
+
+    // 쇼다운 평균 족보 (0 = TopCard ~ 9 = RoyalFlush)
+    double showdown_strength() const {
+        return showdowns ? static_cast<double>(showdown_rank_sum) / showdowns : 0.0;
+    }
+
+private:
+    static double ratio(std::uint64_t num, std::uint64_t den) {
+        return den ? static_cast<double>(num) / static_cast<double>(den) : 0.0;
+    }
+};
+
+/*
+플레이어 한 명의 누적 통계
+
+여러 테이블 스레드가 동시에 갱신하므로 카운터는 모두 atomic 이고 락을 쓰지 않는다.
+비율의 분모를 먼저 relaxed 로 올리고 분자는 release 로 올린다.
+snapshot() 은 분자를 acquire 로 먼저 읽으므로 분자 <= 분모 가 항상 성립한다.
+*/
+class alignas(64) PlayerStats {
+public:
+    void on_hand_start() {
+        hands_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // facing_raise: 빅블라인드보다 높은 베팅을 마주한 상태
+    // first_voluntary: 이번 핸드에서 처음으로 자발적으로 칩을 넣는 액션
+    void on_action(Action action, bool facing_raise, bool first_voluntary) {
+        if (facing_raise) faced_raise_.fetch_add(1, std::memory_order_relaxed);
+
+        switch (action) {
+            case Action::Bet:
+            case Action::Raise:
+            case Action::AllIn:
+                total_actions_.fetch_add(1, std::memory_order_relaxed);
+                aggressive_.fetch_add(1, std::memory_order_release);
+                break;
+            case Action::Fold:
+                total_actions_.fetch_add(1, std::memory_order_relaxed);
+                if (facing_raise) folded_to_raise_.fetch_add(1, std::memory_order_release);
+                break;
+            case Action::Check:
+            case Action::Call:
+                total_actions_.fetch_add(1, std::memory_order_relaxed);
+                break;
+        }
+
+        if (first_voluntary) vpip_.fetch_add(1, std::memory_order_release);
+    }
+
+    void on_showdown(HandRank rank) {
+        showdown_rank_sum_.fetch_add(static_cast<std::uint64_t>(rank), std::memory_order_relaxed);
+        showdowns_.fetch_add(1, std::memory_order_release);
+    }
+
+    OpponentProfile snapshot() const {
+        OpponentProfile p;
+        // 분자 먼저 (acquire), 분모 나중
+        p.vpip = vpip_.load(std::memory_order_acquire);
+        p.aggressive = aggressive_.load(std::memory_order_acquire);
+        p.folded_to_raise = folded_to_raise_.load(std::memory_order_acquire);
+        p.showdowns = showdowns_.load(std::memory_order_acquire);
+        p.showdown_rank_sum = showdown_rank_sum_.load(std::memory_order_relaxed);
+
+        p.hands = hands_.load(std::memory_order_relaxed);
+        p.passive = total_actions_.load(std::memory_order_relaxed) - p.aggressive;
+        p.faced_raise = faced_raise_.load(std::memory_order_relaxed);
+        return p;
+    }
+
+private:
+    std::atomic<std::uint64_t> hands_{0};
+    std::atomic<std::uint64_t> vpip_{0};
+    std::atomic<std::uint64_t> total_actions_{0};
+    std::atomic<std::uint64_t> aggressive_{0};
+    std::atomic<std::uint64_t> faced_raise_{0};
+    std::atomic<std::uint64_t> folded_to_raise_{0};
+    std::atomic<std::uint64_t> showdowns_{0};
+    std::atomic<std::uint64_t> showdown_rank_sum_{0};
+};
+
+/*
+이름 → PlayerStats
+
+등록(player)만 뮤텍스를 잡는다. 돌려받은 참조는 트래커가 살아 있는 동안 유효하므로
+Game 과 SmartAI 는 참조를 들고 있다가 락 없이 갱신/조회한다.
+*/
+class StatsTracker {
+public:
+    PlayerStats& player(std::string_view name) {
+        std::lock_guard lock(mutex_);
+        auto it = players_.find(std::string{name});
+        if (it == players_.end()) {
+            it = players_.emplace(std::string{name}, std::make_unique<PlayerStats>()).first;
+        }
+        return *it->second;
+    }
+
+    OpponentProfile snapshot(std::string_view name) {
+        return player(name).snapshot();
+    }
+
+private:
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::unique_ptr<PlayerStats>> players_;
+};
+
+} // namespace poker
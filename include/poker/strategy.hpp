@@ -1,15 +1,102 @@
 #pragma once
 #include "hand.hpp"
 #include "action.hpp"
+#include "card_set.hpp"
+#include "evaluator.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <tuple>
+#include <utility>
 
 namespace poker {
 
+namespace detail {
+
+    // Chen 공식의 높은 카드 점수 (rank 0 = Two)
+    inline double chen_card(int rank) {
+        switch (rank) {
+            case 12: return 10.0;
+            case 11: return 8.0;
+            case 10: return 7.0;
+            case 9:  return 6.0;
+            default: return (rank + 2) / 2.0;
+        }
+    }
+
+    // 두 장의 Chen 점수 (-1 ~ 20). 카드 인덱스 = suit * 13 + rank
+    inline double chen_score(int a, int b) {
+        const int high = std::max(a % 13, b % 13);
+        const int low = std::min(a % 13, b % 13);
+        double score = chen_card(high);
+        if (high == low) return std::max(score * 2.0, 5.0);
+        if (a / 13 == b / 13) score += 2.0;
+        const int gap = high - low - 1;
+        score -= gap == 0 ? 0.0 : gap == 1 ? 1.0 : gap == 2 ? 2.0 : gap == 3 ? 4.0 : 5.0;
+        if (gap <= 1 && high < 10) score += 1.0;   // 퀸 아래 커넥터
+        return std::ceil(score);
+    }
+
+    // 아직 N장이 안 보일 때(홀덤 프리플롭, 스터드 3·4번째 스트리트) 의 핸드 점수
+    // 두 장 조합 중 가장 좋은 Chen 점수. 트립스 이상은 최고점
+    inline double early_score(CardSet visible) {
+        std::array<int, 7> cards{};
+        size_t count = 0;
+        for (std::uint64_t b = visible.bits(); b && count < cards.size(); b &= b - 1) {
+            cards[count++] = std::countr_zero(b);
+        }
+        std::array<int, 13> ranks{};
+        double best = count == 1 ? chen_card(cards[0] % 13) : -1.0;
+        for (size_t i = 0; i < count; ++i) {
+            if (++ranks[static_cast<size_t>(cards[i] % 13)] >= 3) return 20.0;
+            for (size_t j = i + 1; j < count; ++j) best = std::max(best, chen_score(cards[i], cards[j]));
+        }
+        return best;
+    }
+
+} // namespace detail
+
 template<typename Derived, size_t N = 5>
 class Strategy {
 public:
     Decision decide(const Hand<N>& hand, size_t pot, size_t to_call) {
         return static_cast<Derived*>(this)->decide_impl(hand, pot, to_call);
     }
+
+    // 스트리트가 여러 개인 변형(스터드, 홀덤): 지금 보이는 자기 카드 + 공용 카드.
+    // 전략이 decide_impl(CardSet, ...) 을 따로 구현하지 않으면
+    // N장 이상 보일 때 가장 좋은 N장으로 Hand<N> 판단을 그대로 쓰고,
+    // 그 전에는 Chen 점수로 10 이상 레이즈, 7 이상 콜, 나머지는 공짜가 아니면 폴드
+    Decision decide(CardSet visible, size_t pot, size_t to_call) {
+        auto& self = *static_cast<Derived*>(this);
+        if constexpr (requires { self.decide_impl(visible, pot, to_call); }) {
+            return self.decide_impl(visible, pot, to_call);
+        } else {
+            if (visible.size() >= N) {
+                CardSet best = N == 5 ? best_five(visible) : visible;
+                if (best.size() == N) return decide(make_hand<N>(best), pot, to_call);
+            }
+            const double score = detail::early_score(visible);
+            if (score >= 10.0) return Decision{Action::Raise, std::max(pot / 2, to_call * 2)};
+            if (to_call == 0) return Decision{Action::Check, 0};
+            if (score >= 7.0) return Decision{Action::Call, to_call};
+            return Decision{Action::Fold, 0};
+        }
+    }
 };
 
+// tuple 안에서 난수를 쓰는 전략(seed() 가 있는 전략) 을 seed 로 고정한다. 전략마다 다른 값을 받는다
+template<typename... Strategies>
+void seed_strategies(std::tuple<Strategies...>& strategies, std::uint32_t seed) {
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+        ([&](auto& strategy) {
+            if constexpr (requires { strategy.seed(seed); }) {
+                strategy.seed(seed * 0x9E3779B9u + static_cast<std::uint32_t>(Is));
+            }
+        }(std::get<Is>(strategies)), ...);
+    }(std::index_sequence_for<Strategies...>{});
+}
+
 } // namespace poker
\ No newline at end of file
@@ -0,0 +1,410 @@
+#pragma once
+
+#include "checkpoint.hpp"
+#include "deck_batch.hpp"
+#include "game.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace poker {
+
+struct BlindLevel {
+    size_t small_blind{10};
+    std::uint64_t hands{10};    // 테이블마다 이 레벨에서 치는 핸드 수
+};
+
+// 스택 1500 기준 터보 구조. 스케줄이 끝나면 마지막 레벨 길이마다 1.5배씩 계속 오른다
+inline std::vector<BlindLevel> default_blind_schedule() {
+    return {{10, 10}, {15, 10}, {25, 10}, {50, 10}, {75, 10}, {100, 10}, {150, 10},
+            {200, 10}, {300, 10}, {400, 10}, {600, 10}, {800, 10}, {1000, 10}};
+}
+
+struct TournamentOptions {
+    size_t entrants{900};
+    size_t table_size{9};
+    size_t stack{1500};
+    std::vector<BlindLevel> schedule{default_blind_schedule()};
+    double paid_fraction{0.15};         // 상금권 비율
+    std::uint64_t max_steps{100'000};   // 안 끝나면 여기서 멈추고 남은 칩 순으로 순위
+    unsigned threads{0};
+    std::uint32_t seed{0};              // 0 = random_device
+    std::string checkpoint{};           // 체크포인트 파일. 비어 있으면 안 쓰고, 있으면 거기서 이어서 친다
+    std::uint64_t checkpoint_every{100}; // 단계 수
+};
+
+struct TournamentStrategyResult {
+    std::string name;
+    size_t entrants{0};
+    size_t wins{0};
+    size_t cashes{0};               // 상금권 안에 든 엔트리 수
+    double average_place{0.0};      // 1 = 우승
+};
+
+struct TournamentResult {
+    std::vector<TournamentStrategyResult> strategies;
+    std::vector<size_t> places;     // 엔트리 번호 → 최종 순위 (엔트리 i 의 전략은 i % 전략 수)
+    std::uint64_t steps{0};         // 모든 테이블이 한 핸드씩 치는 단계 수
+    std::uint64_t hands{0};
+    std::uint64_t moves{0};         // 밸런싱과 테이블 해체로 자리를 옮긴 횟수
+    size_t tables_broken{0};
+    size_t final_small_blind{0};
+};
+
+/*
+멀티 테이블 토너먼트
+
+    Tournament<SmartAI, AggressiveAI> tournament{{"Smart", "Aggressive"}, options};
+    auto result = tournament.run();
+
+엔트리 i 는 i % 전략 수 번 전략으로 앉고, 시드로 섞은 순서대로 테이블에 고르게 나눈다.
+한 단계 = 모든 테이블이 워커 풀(run 동안 한 번 만든 WorkerPool) 에서 동시에 한 핸드씩. 단계 사이(모든 테이블이 핸드 사이)에
+조정 스레드 혼자
+1. 칩이 0인 플레이어를 탈락시키고 (같은 단계 탈락은 핸드 시작 스택이 큰 쪽이 높은 순위)
+2. 남은 인원에 필요한 것보다 테이블이 많으면 가장 작은 테이블을 깨서 작은 테이블들로 흩고
+3. 테이블 인원 차이가 2 이상이면 큰 테이블에서 작은 테이블로 한 명씩 옮긴다
+테이블은 자기 Game/전략 인스턴스만 만지므로 핸드 중에도, 자리를 옮길 때도 락이 없다.
+블라인드는 단계 수로 정해져서 모든 테이블이 같은 레벨에서 친다.
+
+options.checkpoint 를 주면 checkpoint_every 단계마다 (그리고 끝날 때) 단계 사이의 전체 상태
+(순위, 칩, 테이블별 좌석 순서와 딜러, 누적 카운터, 시드) 를 CheckpointFile 에 남긴다.
+덱은 시드와 단계 번호로, 전략 난수는 단계마다 (시드, 단계, 테이블 번호) 로 다시 시드하므로
+따로 저장하지 않는다. 같은 설정으로 다시 run() 하면 마지막 체크포인트에서 이어서 치고
+끊기지 않은 실행과 결과가 같다 (seed() 가 없는 전략이 난수를 쓰거나, MctsAI 처럼 시간 한도로 멈추면 예외).
+*/
+template<typename... Strategies>
+class Tournament {
+public:
+    static constexpr size_t STRATEGIES = sizeof...(Strategies);
+    static_assert(STRATEGIES >= 1, "Tournament needs at least one strategy");
+
+    explicit Tournament(std::array<std::string, STRATEGIES> names, TournamentOptions options = {})
+        : names_(std::move(names)), options_(std::move(options))
+    {
+        if (options_.entrants < 2) throw std::invalid_argument("Tournament needs at least two entrants");
+        if (options_.table_size < 2 || options_.table_size > GameState::MAX_SEATS) {
+            throw std::invalid_argument("Table size must be between 2 and GameState::MAX_SEATS");
+        }
+        if (options_.stack == 0) throw std::invalid_argument("Starting stack must be positive");
+        if (options_.schedule.empty()) throw std::invalid_argument("Blind schedule is empty");
+        if (!options_.checkpoint.empty() && options_.checkpoint_every == 0) {
+            throw std::invalid_argument("Checkpoint interval must be positive");
+        }
+        for (const auto& level : options_.schedule) {
+            if (level.small_blind == 0 || level.hands == 0) {
+                throw std::invalid_argument("Blind levels need a positive small blind and length");
+            }
+        }
+    }
+
+    TournamentResult run() const {
+        std::uint32_t seed = options_.seed ? options_.seed : std::random_device{}();
+        const size_t n = options_.entrants;
+        TournamentResult result;
+        result.places.assign(n, 0);
+
+        // Game 이 Player 포인터를 들고 있으므로 재할당 없이 한 번에 만든다
+        std::vector<Player<5>> players;
+        players.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+            players.emplace_back(names_[i % STRATEGIES] + " #" + std::to_string(i), options_.stack);
+        }
+
+        std::vector<std::unique_ptr<Table>> tables;
+        const size_t table_count = (n + options_.table_size - 1) / options_.table_size;
+        size_t remaining = n;
+
+        std::optional<CheckpointFile> checkpoint;
+        std::optional<std::vector<std::byte>> saved;
+        if (!options_.checkpoint.empty()) {
+            checkpoint.emplace(options_.checkpoint, checkpoint_capacity(table_count));
+            saved = checkpoint->load();
+        }
+
+        if (saved) {
+            resume(*saved, seed, remaining, tables, players, result);
+        } else {
+            // 시드로 섞어서 한 명씩 돌아가며 앉힌다 (인원 차이 최대 1)
+            std::vector<size_t> order(n);
+            std::iota(order.begin(), order.end(), size_t{0});
+            std::shuffle(order.begin(), order.end(), std::mt19937{seed});
+
+            for (size_t t = 0; t < table_count; ++t) {
+                tables.push_back(std::make_unique<Table>(options_.schedule.front().small_blind));
+            }
+            for (size_t i = 0; i < n; ++i) seat(*tables[i % table_count], players, order[i]);
+        }
+
+        std::vector<size_t> start_chips(n);
+        std::vector<size_t> busted;
+        DeckBatch decks;
+        CheckpointWriter writer;
+        // 단계마다 스레드를 새로 띄우지 않도록 풀을 한 번 만든다 (테이블 수보다 많을 필요는 없다)
+        WorkerPool pool(static_cast<unsigned>(std::min<size_t>(
+            options_.threads ? options_.threads : default_thread_count(), tables.size())));
+
+        while (remaining > 1 && result.steps < options_.max_steps) {
+            const size_t small_blind = blind_at(result.steps);
+            for (auto& table : tables) {
+                table->game.set_small_blind(small_blind);
+                for (size_t e : table->entrants) start_chips[e] = players[e].chips();
+            }
+
+            // 이번 단계의 덱을 한 번에 섞는다 (덱 번호 = 단계 * 처음 테이블 수 + 테이블)
+            if (decks.size() != tables.size()) decks = DeckBatch(tables.size());
+            decks.generate(seed, result.steps * table_count);
+
+            pool.run(tables.size(), [&](size_t t, unsigned) {
+                if (tables[t]->entrants.size() < 2) return;
+                seed_strategies(tables[t]->strategies, strategy_seed(seed, result.steps, t));
+                tables[t]->game.start_round(decks.deck(t));
+            });
+            for (auto& table : tables) result.hands += table->entrants.size() >= 2;
+            ++result.steps;
+            result.final_small_blind = small_blind;
+
+            // 1. 탈락
+            busted.clear();
+            for (auto& table : tables) {
+                std::erase_if(table->entrants, [&](size_t e) {
+                    if (players[e].chips() > 0) return false;
+                    table->game.remove_player(&players[e]);
+                    busted.push_back(e);
+                    return true;
+                });
+            }
+            std::sort(busted.begin(), busted.end(), [&](size_t a, size_t b) {
+                return start_chips[a] != start_chips[b] ? start_chips[a] > start_chips[b] : a < b;
+            });
+            for (size_t k = 0; k < busted.size(); ++k) {
+                result.places[busted[k]] = remaining - busted.size() + 1 + k;
+            }
+            remaining -= busted.size();
+
+            // 2, 3. 테이블 해체와 밸런싱
+            if (!busted.empty()) rebalance(tables, players, remaining, result);
+
+            // 테이블이 모두 쉬는 사이라 본문 memcpy 만 기다리면 된다 (fsync 는 CheckpointFile 스레드)
+            if (checkpoint && result.steps % options_.checkpoint_every == 0) {
+                write_checkpoint(writer, seed, remaining, tables, players, result);
+                checkpoint->save(writer.bytes());
+            }
+        }
+        if (checkpoint) {
+            write_checkpoint(writer, seed, remaining, tables, players, result);
+            checkpoint->save(writer.bytes());
+            checkpoint->wait();     // 마지막 플러시 실패도 여기서 던진다
+        }
+
+        // 끝까지 남은 (또는 max_steps 에서 멈춘) 플레이어는 칩 순
+        std::vector<size_t> alive;
+        for (auto& table : tables) alive.insert(alive.end(), table->entrants.begin(), table->entrants.end());
+        std::sort(alive.begin(), alive.end(), [&](size_t a, size_t b) {
+            return players[a].chips() != players[b].chips() ? players[a].chips() > players[b].chips() : a < b;
+        });
+        for (size_t k = 0; k < alive.size(); ++k) result.places[alive[k]] = k + 1;
+
+        summarize(result);
+        return result;
+    }
+
+private:
+    std::array<std::string, STRATEGIES> names_;
+    TournamentOptions options_;
+
+    // 테이블 하나 = Game + 그 테이블 전용 전략 인스턴스 (워커 스레드끼리 공유하지 않는다)
+    struct Table {
+        Game game;
+        std::tuple<Strategies...> strategies;
+        std::vector<size_t> entrants;   // 좌석 순서의 엔트리 번호
+
+        explicit Table(size_t small_blind) : game(small_blind, nullptr) {}
+    };
+
+    // (시드, 단계, 테이블 번호) → 그 테이블 전략들의 이번 단계 시드 (splitmix64 마무리)
+    static std::uint32_t strategy_seed(std::uint32_t seed, std::uint64_t step, size_t table) {
+        std::uint64_t x = (std::uint64_t{seed} << 32) ^ (step * 0x9E3779B97F4A7C15ull) ^ (table * 0xD1B54A32D192ED03ull);
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ull;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBull;
+        return static_cast<std::uint32_t>(x ^ (x >> 31));
+    }
+
+    size_t blind_at(std::uint64_t step) const {
+        for (const auto& level : options_.schedule) {
+            if (step < level.hands) return level.small_blind;
+            step -= level.hands;
+        }
+        // 스케줄 이후: 마지막 레벨 길이마다 1.5배 (전체 칩을 넘지는 않게)
+        const auto& last = options_.schedule.back();
+        const double cap = static_cast<double>(options_.stack) * static_cast<double>(options_.entrants);
+        double small_blind = static_cast<double>(last.small_blind);
+        for (std::uint64_t k = step / last.hands + 1; k > 0 && small_blind < cap; --k) small_blind *= 1.5;
+        return static_cast<size_t>(std::min(small_blind, cap));
+    }
+
+    void seat(Table& table, std::vector<Player<5>>& players, size_t entrant) const {
+        seat_strategy(table.game, &players[entrant], table.strategies, entrant % STRATEGIES,
+                      std::index_sequence_for<Strategies...>{});
+        table.entrants.push_back(entrant);
+    }
+
+    // 마지막 좌석의 플레이어를 다른 테이블로
+    void move_last(Table& from, Table& to, std::vector<Player<5>>& players, TournamentResult& result) const {
+        size_t entrant = from.entrants.back();
+        from.entrants.pop_back();
+        from.game.remove_player(&players[entrant]);
+        seat(to, players, entrant);
+        ++result.moves;
+    }
+
+    void rebalance(std::vector<std::unique_ptr<Table>>& tables, std::vector<Player<5>>& players,
+                   size_t remaining, TournamentResult& result) const {
+        auto by_size = [](const auto& a, const auto& b) { return a->entrants.size() < b->entrants.size(); };
+
+        // 필요한 테이블 수보다 많으면 가장 작은 테이블을 깬다
+        const size_t needed = (remaining + options_.table_size - 1) / options_.table_size;
+        while (tables.size() > needed) {
+            auto smallest = std::min_element(tables.begin(), tables.end(), by_size);
+            std::unique_ptr<Table> broken = std::move(*smallest);
+            tables.erase(smallest);
+            while (!broken->entrants.empty()) {
+                move_last(*broken, **std::min_element(tables.begin(), tables.end(), by_size), players, result);
+            }
+            ++result.tables_broken;
+        }
+
+        // 인원 차이가 1 이하가 될 때까지 큰 테이블 → 작은 테이블
+        while (tables.size() > 1) {
+            auto [small, large] = std::minmax_element(tables.begin(), tables.end(), by_size);
+            if ((*large)->entrants.size() - (*small)->entrants.size() <= 1) break;
+            move_last(**large, **small, players, result);
+        }
+    }
+
+    // 이 설정으로 만든 체크포인트인지 확인하는 머리말 (결과 집계에만 쓰는 값은 빼고)
+    void write_setup(CheckpointWriter& out) const {
+        out.put(std::uint64_t{STRATEGIES});
+        out.put(options_.entrants);
+        out.put(options_.table_size);
+        out.put(options_.stack);
+        out.put(options_.schedule);
+    }
+
+    // 처음 체크포인트가 가장 크다 (이후로는 테이블과 좌석만 줄어든다)
+    size_t checkpoint_capacity(size_t table_count) const {
+        CheckpointWriter setup;
+        write_setup(setup);
+        return setup.bytes().size() + 128 + 2 * sizeof(size_t) * options_.entrants +
+               table_count * (16 + sizeof(size_t) * options_.table_size);
+    }
+
+    void write_checkpoint(CheckpointWriter& out, std::uint32_t seed, size_t remaining,
+                          const std::vector<std::unique_ptr<Table>>& tables,
+                          const std::vector<Player<5>>& players, const TournamentResult& result) const {
+        out.clear();
+        write_setup(out);
+        out.put(seed);
+        out.put(result.steps);
+        out.put(result.hands);
+        out.put(result.moves);
+        out.put(result.tables_broken);
+        out.put(result.final_small_blind);
+        out.put(remaining);
+        out.put(result.places);
+        std::vector<size_t> chips(players.size());
+        for (size_t i = 0; i < players.size(); ++i) chips[i] = players[i].chips();
+        out.put(chips);
+        out.put(tables.size());
+        for (const auto& table : tables) {
+            out.put(table->game.snapshot().dealer);
+            out.put(table->entrants);
+        }
+    }
+
+    // write_checkpoint 의 역순. 테이블은 같은 좌석 순서로 다시 앉히고 딜러와 칩은 GameState 로 되돌린다
+    void resume(const std::vector<std::byte>& saved, std::uint32_t& seed, size_t& remaining,
+                std::vector<std::unique_ptr<Table>>& tables, std::vector<Player<5>>& players,
+                TournamentResult& result) const {
+        CheckpointWriter setup;
+        write_setup(setup);
+        const auto expected = setup.bytes();
+        if (saved.size() < expected.size() || !std::equal(expected.begin(), expected.end(), saved.begin())) {
+            throw std::invalid_argument("Checkpoint " + options_.checkpoint + " belongs to a different tournament");
+        }
+
+        CheckpointReader in(std::span<const std::byte>(saved).subspan(expected.size()));
+        seed = in.get<std::uint32_t>();
+        if (options_.seed && seed != options_.seed) {
+            throw std::invalid_argument("Checkpoint " + options_.checkpoint + " was played with another seed");
+        }
+        result.steps = in.get<std::uint64_t>();
+        result.hands = in.get<std::uint64_t>();
+        result.moves = in.get<std::uint64_t>();
+        result.tables_broken = in.get<size_t>();
+        result.final_small_blind = in.get<size_t>();
+        remaining = in.get<size_t>();
+        result.places = in.get_vector<size_t>();
+        auto chips = in.get_vector<size_t>();
+        if (result.places.size() != players.size() || chips.size() != players.size()) {
+            throw std::runtime_error("Checkpoint entrant count is inconsistent");
+        }
+
+        const auto table_count = in.get<size_t>();
+        for (size_t t = 0; t < table_count; ++t) {
+            const auto dealer = in.get<std::uint8_t>();
+            const auto entrants = in.get_vector<size_t>();
+            if (entrants.size() > options_.table_size) throw std::runtime_error("Checkpoint table is overfull");
+
+            auto& table = *tables.emplace_back(std::make_unique<Table>(options_.schedule.front().small_blind));
+            for (size_t e : entrants) {
+                if (e >= players.size()) throw std::runtime_error("Checkpoint entrant is out of range");
+                seat(table, players, e);
+            }
+            auto state = table.game.snapshot();
+            state.dealer = dealer;
+            for (size_t i = 0; i < entrants.size(); ++i) state.seats[i].chips = static_cast<std::uint32_t>(chips[entrants[i]]);
+            table.game.restore(state);
+        }
+        if (!in.done()) throw std::runtime_error("Checkpoint has trailing data");
+    }
+
+    void summarize(TournamentResult& result) const {
+        const size_t n = result.places.size();
+        const size_t paid = std::max<size_t>(1, static_cast<size_t>(static_cast<double>(n) * options_.paid_fraction));
+
+        result.strategies.resize(STRATEGIES);
+        for (size_t s = 0; s < STRATEGIES; ++s) result.strategies[s].name = names_[s];
+        for (size_t i = 0; i < n; ++i) {
+            auto& r = result.strategies[i % STRATEGIES];
+            ++r.entrants;
+            r.wins += result.places[i] == 1;
+            r.cashes += result.places[i] <= paid;
+            r.average_place += static_cast<double>(result.places[i]);
+        }
+        for (auto& r : result.strategies) {
+            if (r.entrants) r.average_place /= static_cast<double>(r.entrants);
+        }
+    }
+
+    // 런타임 번호 → tuple 의 전략 (Fold Expression)
+    template<size_t... Is>
+    static void seat_strategy(Game& game, Player<5>* player, std::tuple<Strategies...>& strategies,
+                              size_t index, std::index_sequence<Is...>) {
+        ((index == Is ? game.add_player(player, std::get<Is>(strategies)) : void()), ...);
+    }
+};
+
+} // namespace poker
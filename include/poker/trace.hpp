@@ -0,0 +1,248 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace poker {
+
+// 구간 하나. name/category 는 문자열 리터럴처럼 프로그램 끝까지 살아 있어야 한다.
+struct TraceRecord {
+    const char* name{nullptr};
+    const char* category{nullptr};
+    std::uint64_t start_ns{0};
+    std::uint64_t end_ns{0};
+};
+
+namespace detail {
+
+    /*
+    스레드 하나의 기록 링 (SPSC)
+
+    쓰는 쪽은 소유 스레드 하나, 읽는 쪽은 Tracer::write_json 하나뿐이라
+    head/tail 두 원자 변수만으로 락 없이 동작한다. 가득 차면 새 구간을 버리고 센다.
+    */
+    class TraceBuffer {
+    public:
+        TraceBuffer(size_t capacity, std::uint32_t id)
+            : records_(std::bit_ceil(std::max<size_t>(capacity, 2))),
+              mask_(records_.size() - 1),
+              id_(id)
+        {}
+
+        void push(const TraceRecord& record) {
+            auto head = head_.load(std::memory_order_relaxed);
+            if (head - tail_.load(std::memory_order_acquire) == records_.size()) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            records_[head & mask_] = record;
+            head_.store(head + 1, std::memory_order_release);
+        }
+
+        template<typename F>
+        void drain(F&& f) {
+            auto tail = tail_.load(std::memory_order_relaxed);
+            auto head = head_.load(std::memory_order_acquire);
+            for (; tail != head; ++tail) f(records_[tail & mask_]);
+            tail_.store(tail, std::memory_order_release);
+        }
+
+        std::uint32_t id() const { return id_; }
+        std::uint64_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+        bool retired() const { return retired_.load(std::memory_order_acquire); }
+        void retire() { retired_.store(true, std::memory_order_release); }
+        // 끝난 스레드의 링을 새 스레드가 이어 쓴다 (레지스트리 락 안에서만)
+        void reuse() { retired_.store(false, std::memory_order_relaxed); }
+
+    private:
+        std::vector<TraceRecord> records_;
+        size_t mask_;
+        std::uint32_t id_;
+        std::atomic<bool> retired_{false};      // 소유 스레드가 끝났다
+        std::atomic<std::uint64_t> dropped_{0};
+        alignas(64) std::atomic<std::uint64_t> head_{0};  // 소유 스레드만 쓴다
+        alignas(64) std::atomic<std::uint64_t> tail_{0};  // write_json 만 쓴다
+    };
+
+} // namespace detail
+
+/*
+Chrome trace-event (Perfetto 호환) 타임라인 기록기
+
+    Tracer::enable();
+    ... 게임/시뮬레이션 ...
+    Tracer::write_json("trace.json");   // chrome://tracing 이나 ui.perfetto.dev 에서 연다
+
+꺼져 있으면 TraceSpan 은 원자 bool 하나를 relaxed 로 읽고 끝난다.
+켜져 있으면 스레드마다 처음 기록할 때 링을 하나 받고(이때만 락), 이후로는 자기 링에만 쓴다.
+끝난 스레드의 링은 다음에 시작하는 스레드가 물려받으므로 (같은 tid 트랙에 이어서 그려진다)
+parallel_for 처럼 스레드를 계속 새로 만들어도 링 수는 동시에 살아 있는 스레드 수를 넘지 않는다.
+*/
+class Tracer {
+public:
+    static void enable(size_t records_per_thread = 1 << 14) {
+        capacity_.store(records_per_thread, std::memory_order_relaxed);
+        enabled_.store(true, std::memory_order_release);
+    }
+
+    static void disable() {
+        enabled_.store(false, std::memory_order_release);
+    }
+
+    static bool enabled() {
+        return enabled_.load(std::memory_order_relaxed);
+    }
+
+    static std::uint64_t now_ns() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - epoch()).count());
+    }
+
+    static void record(const char* name, const char* category, std::uint64_t start_ns, std::uint64_t end_ns) {
+        local_buffer().push(TraceRecord{name, category, start_ns, end_ns});
+    }
+
+    // 지금까지 모인 구간을 비워서 trace-event JSON 으로 쓴다. 쓴 구간 수를 돌려준다
+    static size_t write_json(std::ostream& out) {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+
+        size_t count = 0;
+        bool first = true;
+        out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        for (auto& buffer : reg.buffers) {
+            if (!first) out << ",\n";
+            first = false;
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->id()
+                << ",\"args\":{\"name\":\"thread " << buffer->id() << "\"}}";
+
+            buffer->drain([&](const TraceRecord& r) {
+                // ts/dur 단위는 마이크로초 (소수점으로 ns 까지)
+                out << ",\n{\"name\":\"" << r.name << "\",\"cat\":\"" << r.category
+                    << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->id()
+                    << ",\"ts\":" << micros(r.start_ns).data()
+                    << ",\"dur\":" << micros(r.end_ns - r.start_ns).data() << "}";
+                ++count;
+            });
+        }
+        out << "\n]}\n";
+
+        // 끝난 스레드의 링은 다 비웠으니 정리
+        std::erase_if(reg.buffers, [&](const auto& buffer) {
+            if (!buffer->retired()) return false;
+            reg.retired_dropped += buffer->dropped();
+            return true;
+        });
+        return count;
+    }
+
+    static size_t write_json(const std::string& path) {
+        std::ofstream out(path);
+        if (!out) throw std::runtime_error("Cannot open trace file: " + path);
+        return write_json(out);
+    }
+
+    // 링이 가득 차서 버린 구간 수
+    static std::uint64_t dropped() {
+        auto& reg = registry();
+        std::lock_guard lock(reg.mutex);
+        std::uint64_t total = reg.retired_dropped;
+        for (auto& buffer : reg.buffers) total += buffer->dropped();
+        return total;
+    }
+
+private:
+    static inline std::atomic<bool> enabled_{false};
+    static inline std::atomic<size_t> capacity_{1 << 14};
+
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::shared_ptr<detail::TraceBuffer>> buffers;
+        std::uint32_t next_id{1};
+        std::uint64_t retired_dropped{0};
+    };
+
+    static Registry& registry() {
+        static Registry reg;
+        return reg;
+    }
+
+    static std::chrono::steady_clock::time_point epoch() {
+        static const auto start = std::chrono::steady_clock::now();
+        return start;
+    }
+
+    // 스레드가 끝나면 링을 retired 로 표시만 한다 (남은 구간은 write_json 이 가져가고, 링은 다음 스레드가 물려받는다)
+    struct ThreadSlot {
+        std::shared_ptr<detail::TraceBuffer> buffer;
+        ~ThreadSlot() { if (buffer) buffer->retire(); }
+    };
+
+    static detail::TraceBuffer& local_buffer() {
+        thread_local ThreadSlot slot;
+        if (!slot.buffer) {
+            auto& reg = registry();
+            std::lock_guard lock(reg.mutex);
+            auto retired = std::find_if(reg.buffers.begin(), reg.buffers.end(),
+                                        [](const auto& buffer) { return buffer->retired(); });
+            if (retired != reg.buffers.end()) {
+                slot.buffer = *retired;
+                slot.buffer->reuse();
+            } else {
+                slot.buffer = std::make_shared<detail::TraceBuffer>(
+                    capacity_.load(std::memory_order_relaxed), reg.next_id++);
+                reg.buffers.push_back(slot.buffer);
+            }
+        }
+        return *slot.buffer;
+    }
+
+    // ns → "마이크로초.나노초 3자리"
+    static std::array<char, 32> micros(std::uint64_t ns) {
+        std::array<char, 32> text{};
+        std::snprintf(text.data(), text.size(), "%llu.%03llu",
+                      static_cast<unsigned long long>(ns / 1000),
+                      static_cast<unsigned long long>(ns % 1000));
+        return text;
+    }
+};
+
+// 스코프 하나를 구간으로 기록 (RAII)
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, const char* category = "poker")
+        : name_(name), category_(category)
+    {
+        if (Tracer::enabled()) {
+            active_ = true;
+            start_ns_ = Tracer::now_ns();
+        }
+    }
+
+    ~TraceSpan() {
+        if (active_) Tracer::record(name_, category_, start_ns_, Tracer::now_ns());
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+private:
+    const char* name_;
+    const char* category_;
+    std::uint64_t start_ns_{0};
+    bool active_{false};
+};
+
+} // namespace poker
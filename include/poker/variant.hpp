@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstdint>
+
+namespace poker {
+
+// 한 스트리트에 나눠주는 카드. 좌석마다 down(비공개) → up(공개) 순서, 그 다음 공용 카드
+struct Street {
+    std::uint8_t down{0};
+    std::uint8_t up{0};
+    std::uint8_t board{0};
+};
+
+/*
+게임 변형 정책
+
+    struct MyVariant {
+        static constexpr const char* NAME = "...";
+        static constexpr std::array<Street, K> STREETS{...};   // 스트리트마다 베팅 한 바퀴
+    };
+
+BasicGame<V> / BasicGameState<V> 가 딜 순서, 스트리트 수, 쇼다운 카드 수를 전부
+컴파일 타임 상수로 받아서 변형마다 따로 인스턴스화된다 (런타임 분기 없음).
+블라인드는 모든 변형이 같다 (스터드의 앤티/브링인 대신 SB/BB).
+*/
+template<typename V>
+concept GameVariant = requires {
+    { V::NAME } -> std::convertible_to<const char*>;
+    { V::STREETS[0] } -> std::convertible_to<Street>;
+} && V::STREETS.size() >= 1;
+
+// 5장 받고 베팅 한 번 (이 엔진의 기본 게임)
+struct FiveCardDraw {
+    static constexpr const char* NAME = "Five-card draw";
+    static constexpr std::array<Street, 1> STREETS{{{5, 0, 0}}};
+};
+
+// 1장 비공개 + 1장 공개, 이후 공개 카드 1장씩
+struct FiveCardStud {
+    static constexpr const char* NAME = "Five-card stud";
+    static constexpr std::array<Street, 4> STREETS{{{1, 1, 0}, {0, 1, 0}, {0, 1, 0}, {0, 1, 0}}};
+};
+
+// 2장 비공개 + 1장 공개, 공개 3번, 마지막은 비공개. 7장 중 가장 좋은 5장
+struct SevenCardStud {
+    static constexpr const char* NAME = "Seven-card stud";
+    static constexpr std::array<Street, 5> STREETS{{{2, 1, 0}, {0, 1, 0}, {0, 1, 0}, {0, 1, 0}, {1, 0, 0}}};
+};
+
+// 홀카드 2장 + 플랍/턴/리버 공용 카드 5장
+struct Holdem {
+    static constexpr const char* NAME = "Texas Hold'em";
+    static constexpr std::array<Street, 4> STREETS{{{2, 0, 0}, {0, 0, 3}, {0, 0, 1}, {0, 0, 1}}};
+};
+
+// 정책에서 끌어낸 상수들
+template<GameVariant V>
+struct VariantTraits {
+    static constexpr size_t STREET_COUNT = V::STREETS.size();
+
+    // HOLE_BEFORE[s] / BOARD_BEFORE[s] = 스트리트 s 전까지 나눠준 좌석당 카드 / 공용 카드 수
+    static constexpr auto HOLE_BEFORE = [] {
+        std::array<std::uint8_t, STREET_COUNT + 1> before{};
+        for (size_t s = 0; s < STREET_COUNT; ++s) {
+            before[s + 1] = static_cast<std::uint8_t>(before[s] + V::STREETS[s].down + V::STREETS[s].up);
+        }
+        return before;
+    }();
+    static constexpr auto BOARD_BEFORE = [] {
+        std::array<std::uint8_t, STREET_COUNT + 1> before{};
+        for (size_t s = 0; s < STREET_COUNT; ++s) {
+            before[s + 1] = static_cast<std::uint8_t>(before[s] + V::STREETS[s].board);
+        }
+        return before;
+    }();
+
+    static constexpr size_t HOLE_CARDS = HOLE_BEFORE[STREET_COUNT];
+    static constexpr size_t BOARD_CARDS = BOARD_BEFORE[STREET_COUNT];
+    static constexpr size_t SHOWDOWN_CARDS = HOLE_CARDS + BOARD_CARDS;
+
+    // 좌석 카드 중 공개(up) 카드 위치 비트마스크
+    static constexpr std::uint8_t UP_MASK = [] {
+        unsigned mask = 0;
+        for (size_t s = 0; s < STREET_COUNT; ++s) {
+            for (size_t k = 0; k < V::STREETS[s].up; ++k) mask |= 1u << (HOLE_BEFORE[s] + V::STREETS[s].down + k);
+        }
+        return static_cast<std::uint8_t>(mask);
+    }();
+
+    // 마지막 좌석 카드를 받는 스트리트 (이때부터 Hand<HOLE_CARDS> 가 완성된다)
+    static constexpr size_t HAND_COMPLETE_STREET = [] {
+        size_t s = STREET_COUNT - 1;
+        while (s > 0 && V::STREETS[s].down + V::STREETS[s].up == 0) --s;
+        return s;
+    }();
+
+    // 첫 결정 때 이미 5장짜리 Hand 가 있으면 전략에 Hand<5> 를 그대로 넘긴다
+    static constexpr bool DECIDES_ON_HAND = HOLE_CARDS == 5 && BOARD_CARDS == 0 && STREET_COUNT == 1;
+
+    // 테이블 최대 인원: 좌석 배열 크기(10) 와 덱 52장 중 작은 쪽
+    static constexpr size_t MAX_PLAYERS = std::min<size_t>(10, (52 - BOARD_CARDS) / HOLE_CARDS);
+
+    static_assert(HOLE_CARDS >= 1 && HOLE_CARDS <= 7, "Variant must deal 1 to 7 cards per seat");
+    static_assert(SHOWDOWN_CARDS >= 5 && SHOWDOWN_CARDS <= 7, "Showdown hands must have 5 to 7 cards");
+};
+
+} // namespace poker
@@ -2,12 +2,32 @@
 #include <poker/concepts.hpp>
 #include <poker/hand.hpp>
 #include <poker/deck.hpp>
+#include <poker/deck_batch.hpp>
 #include <poker/player.hpp>
 #include <poker/game.hpp>
+#include <poker/game_state.hpp>
+#include <poker/variant.hpp>
 #include <poker/ai/conservative.hpp>
 #include <poker/ai/aggressive.hpp>
 #include <poker/ai/smart.hpp>
+#include <poker/ai/mcts.hpp>
+#include <poker/equity.hpp>
+#include <poker/hand_equity.hpp>
+#include <poker/equity_cache.hpp>
+#include <poker/hand_indexer.hpp>
+#include <poker/incremental_hand.hpp>
+#include <poker/packed.hpp>
+#include <poker/matchup.hpp>
+#include <poker/tournament.hpp>
+#include <poker/checkpoint.hpp>
+#include <poker/shard.hpp>
+#include <poker/trace.hpp>
+#include <poker/hand_history.hpp>
+#include <poker/event_ring.hpp>
+#include <algorithm>
+#include <cstdio>
 #include <iostream>
+#include <thread>
 
 const char* to_string(poker::HandRank rank) {
     switch (rank) {
@@ -123,6 +143,22 @@ int main() {
     print_hand(hand2);
     std::cout << "Remaining: " << deck.remaining() << "\n";
     
+    // Deck Batch Test
+    std::cout << "\n=== Deck Batch Test ===\n";
+    
+    DeckBatch deck_batch(1000);     // 테이블 1000개 분량을 한 번에
+    deck_batch.generate(42);
+    for (size_t k = 0; k < 2; ++k) {
+        auto order = deck_batch.deck(k);
+        std::cout << "Deck " << k << ": ";
+        print_hand(Hand<5>{order[0].card(), order[1].card(), order[2].card(), order[3].card(), order[4].card()});
+    }
+    
+    DeckBatch single_deck(1);
+    single_deck.generate(42, 1);    // 덱 번호가 같으면 따로 만들어도 같은 순서
+    std::cout << "Deck 1 regenerated: "
+              << (std::ranges::equal(single_deck.deck(0), deck_batch.deck(1)) ? "same" : "different") << "\n";
+    
     // Hand Comparison Test
     std::cout << "\n=== Comparison Test ===\n";
     
@@ -155,6 +191,17 @@ int main() {
         std::cout << "Result: Tie!\n";
     }
     
+    // Packed Test
+    std::cout << "\n=== Packed Test ===\n";
+    
+    PackedHand packed_kings{pair_kings};
+    std::cout << "Hand<5>: " << sizeof(pair_kings) << " bytes -> PackedHand #" << packed_kings.index
+              << " (" << sizeof(packed_kings) << " bytes)\n";
+    std::cout << "HandValue: " << sizeof(HandValue) << " bytes -> 0x" << std::hex
+              << pair_kings.value().packed() << std::dec << " (4 bytes)\n";
+    std::cout << "Unpacked: ";
+    print_hand(packed_kings.hand());
+    
     // Player Test
     std::cout << "\n=== Player Test ===\n";
     
@@ -210,6 +257,282 @@ int main() {
     std::cout << "Aggressive:   " << action_str(decision2.action) << " (" << decision2.amount << ")\n";
     std::cout << "Smart:        " << action_str(decision3.action) << " (" << decision3.amount << ")\n";
     
+    // Equity Test
+    std::cout << "\n=== Equity Test ===\n";
+    
+    EquityOptions holdem;
+    holdem.board_size = 5;
+    holdem.samples = 20'000;
+    
+    auto aa_vs_kk = equity(Range::parse("AA"), Range::parse("KK"), holdem);
+    std::cout << "AA vs KK:            " << aa_vs_kk.equity() << "\n";
+    
+    auto range_vs_range = equity(Range::parse("AA, KK, QQ, AKs"), Range::parse("JJ, TT, AQs, KQs"), holdem);
+    std::cout << "Premium vs Broadway: " << range_vs_range.equity() << "\n";
+    
+    // Incremental Hand Test
+    std::cout << "\n=== Incremental Hand Test ===\n";
+    
+    IncrementalHand street_hand{CardSet::of(Card{Rank::Ace, Suit::Hearts}, Card{Rank::King, Suit::Hearts})};
+    for (auto card : {Card{Rank::Queen, Suit::Hearts}, Card{Rank::Ace, Suit::Clubs},
+                      Card{Rank::Two, Suit::Spades}, Card{Rank::Jack, Suit::Hearts},
+                      Card{Rank::Ten, Suit::Hearts}}) {
+        street_hand.add(card);
+        std::cout << "+ " << to_string(card.rank) << to_string(card.suit)
+                  << " -> " << to_string(street_hand.category()) << "\n";
+    }
+    street_hand.remove(Card{Rank::Ten, Suit::Hearts});
+    std::cout << "- 10H -> " << to_string(street_hand.category()) << "\n";
+    
+    // Indexer Test
+    std::cout << "\n=== Indexer Test ===\n";
+    
+    HandIndexer five_card{5};
+    HandIndexer holdem_river{2, 5};
+    std::cout << "Hand<5> classes:      " << five_card.size() << "\n";
+    std::cout << "Hold'em 2+5 classes:  " << holdem_river.size() << "\n";
+    
+    // 수트만 바꾼 로열 플러시는 같은 인덱스
+    Hand<5> royal_hearts{
+        Card{Rank::Ace, Suit::Hearts},
+        Card{Rank::King, Suit::Hearts},
+        Card{Rank::Queen, Suit::Hearts},
+        Card{Rank::Jack, Suit::Hearts},
+        Card{Rank::Ten, Suit::Hearts}
+    };
+    std::cout << "Royal (S) index: " << five_card.index(royal_flush) << "\n";
+    std::cout << "Royal (H) index: " << five_card.index(royal_hearts) << "\n";
+    
+    // Hand Equity Test
+    std::cout << "\n=== Hand Equity Test ===\n";
+    
+    const auto& hand_equity = HandEquity::shared();   // 강도 등급 7462개 누적 분포
+    auto kings_equity = hand_equity.heads_up(pair_kings);
+    std::cout << "Pair Kings vs 1 random: win " << kings_equity.win << ", tie " << kings_equity.tie
+              << " (" << kings_equity.samples << " hands, exact)\n";
+    std::cout << "Pair Kings vs 3 random: " << hand_equity.equity(pair_kings, 3) << " (approx)\n";
+    std::cout << "Royal flush vs 1 random: " << hand_equity.equity(royal_flush) << "\n";
+    
+    // Matchup Test
+    std::cout << "\n=== Matchup Test ===\n";
+    
+    MatchupOptions matchup_options;
+    matchup_options.max_blocks = 2'000;
+    
+    Matchup<SmartAI, ConservativeAI, AggressiveAI> matchup{{"Smart", "Conservative", "Aggressive"}, matchup_options};
+    auto matchup_result = matchup.run();
+    
+    for (auto& r : matchup_result.strategies) {
+        std::cout << "  " << r.name << ": " << r.bb_per_100 << " bb/100 (+/- " << r.ci95 << ")\n";
+    }
+    std::cout << "  Hands: " << matchup_result.hands << ", Smart is "
+              << (matchup_result.verdict == SprtVerdict::Better ? "better" :
+                  matchup_result.verdict == SprtVerdict::Worse ? "worse" : "inconclusive")
+              << " (SPRT)\n";
+    
+    // Snapshot Test
+    std::cout << "\n=== Snapshot Test ===\n";
+    
+    Player<5> sim_a("SimA", 1000);
+    Player<5> sim_b("SimB", 1000);
+    ConservativeAI sim_ai;
+    Game sim(10, nullptr);
+    sim.add_player(&sim_a, sim_ai);
+    sim.add_player(&sim_b, sim_ai);
+    
+    // 핸드 사이 상태에서 새 핸드를 직접 굴린다
+    GameState state = sim.snapshot();
+    Deck sim_deck(7);
+    sim_deck.shuffle();
+    state.reset(sim_deck.cards());
+    state.post_blinds();
+    state.deal();
+    
+    GameState fork = state;  // memcpy 한 번으로 분기
+    while (!fork.finished) fork.apply(Decision{Action::Call, fork.to_call()});
+    std::cout << "GameState: " << sizeof(GameState) << " bytes, pot " << state.pot
+              << " -> chips after call-down: " << fork.seats[0].chips << " / " << fork.seats[1].chips << "\n";
+    
+    // Variant Test
+    std::cout << "\n=== Variant Test ===\n";
+    
+    // 같은 AI 를 변형마다 따로 인스턴스화된 엔진에 앉힌다
+    auto play_variant = [&]<typename V>(V) {
+        using VariantGame = BasicGame<V>;
+        std::vector<typename VariantGame::PlayerType> seats;
+        seats.reserve(3);
+        VariantGame variant_game(10, nullptr);
+        ConservativeAI cautious;
+        SmartAI clever;
+        for (const char* name : {"Ann", "Ben", "Cat"}) seats.emplace_back(name, 1000);
+        variant_game.add_player(&seats[0], cautious);
+        variant_game.add_player(&seats[1], clever);
+        variant_game.add_player(&seats[2], cautious);
+        variant_game.seed(21);
+        for (int i = 0; i < 5; ++i) {
+            if (std::count_if(seats.begin(), seats.end(), [](const auto& p) { return p.chips() > 0; }) < 2) break;
+            variant_game.start_round();
+        }
+        std::cout << V::NAME << " (" << VariantGame::Traits::STREET_COUNT << " streets, "
+                  << VariantGame::Traits::HOLE_CARDS << "+" << VariantGame::Traits::BOARD_CARDS << " cards): ";
+        for (auto& p : seats) std::cout << p.name() << " " << p.chips() << "  ";
+        std::cout << "\n";
+    };
+    play_variant(FiveCardStud{});
+    play_variant(SevenCardStud{});
+    play_variant(Holdem{});
+    
+    // Tournament Test
+    std::cout << "\n=== Tournament Test ===\n";
+    
+    TournamentOptions tournament_options;
+    tournament_options.entrants = 900;     // 9인 테이블 100개에서 시작
+    tournament_options.seed = 2024;
+    auto tournament = Tournament<SmartAI, ConservativeAI, AggressiveAI>{
+        {"Smart", "Conservative", "Aggressive"}, tournament_options}.run();
+    
+    for (auto& r : tournament.strategies) {
+        std::cout << "  " << r.name << ": avg place " << r.average_place
+                  << ", cashes " << r.cashes << "/" << r.entrants << ", wins " << r.wins << "\n";
+    }
+    std::cout << "  " << tournament.hands << " hands, " << tournament.moves << " seat moves, "
+              << tournament.tables_broken << " tables broken, final SB " << tournament.final_small_blind << "\n";
+    
+    // Equity Cache Test
+    std::cout << "\n=== Equity Cache Test ===\n";
+    
+    // 위 매치업/토너먼트의 SmartAI 들이 모든 스레드에서 같이 쓴 캐시
+    auto& equity_cache = EquityCache::shared();
+    auto cache_stats = equity_cache.stats();
+    std::cout << "Shared cache: " << cache_stats.hits << " hits, " << cache_stats.misses << " misses (hit rate "
+              << cache_stats.hit_rate() << "), " << cache_stats.evictions << " evictions, "
+              << equity_cache.capacity() << " slots\n";
+    
+    // 수트만 바꾼 핸드는 같은 키
+    Hand<5> kings_other_suits{
+        Card{Rank::King, Suit::Diamonds}, Card{Rank::King, Suit::Clubs}, Card{Rank::Ace, Suit::Hearts},
+        Card{Rank::Seven, Suit::Spades}, Card{Rank::Two, Suit::Diamonds}
+    };
+    EquityCache isomorphic_cache(1024, 1);
+    isomorphic_cache.get(EquityCache::key(CardSet{pair_kings}, 2), [&] { return hand_equity.equity(pair_kings, 2); });
+    std::cout << "Pair Kings again (other suits) cached: "
+              << (isomorphic_cache.find(EquityCache::key(CardSet{kings_other_suits}, 2)) ? "yes" : "no") << "\n";
+    
+    // Checkpoint Test
+    std::cout << "\n=== Checkpoint Test ===\n";
+    
+    // 난수를 쓰는 전략 포함: 끊기지 않은 실행 vs 30단계에서 멈췄다가 체크포인트에서 이어 친 실행
+    // (전략 난수는 단계마다 시드로 다시 정해지므로 체크포인트에 없어도 같은 결과)
+    TournamentOptions checkpoint_options;
+    checkpoint_options.entrants = 180;
+    checkpoint_options.seed = 99;
+    using CheckpointTournament = Tournament<ConservativeAI, SmartAI, AggressiveAI>;
+    const std::array<std::string, 3> checkpoint_names{"Conservative", "Smart", "Aggressive"};
+    auto uninterrupted = CheckpointTournament{checkpoint_names, checkpoint_options}.run();
+    
+    std::remove("tournament.ckpt");
+    checkpoint_options.checkpoint = "tournament.ckpt";
+    checkpoint_options.checkpoint_every = 25;
+    checkpoint_options.max_steps = 30;
+    CheckpointTournament{checkpoint_names, checkpoint_options}.run();
+    checkpoint_options.max_steps = TournamentOptions{}.max_steps;
+    auto resumed = CheckpointTournament{checkpoint_names, checkpoint_options}.run();
+    std::remove("tournament.ckpt");
+    
+    std::cout << "Uninterrupted " << uninterrupted.steps << " steps, resumed " << resumed.steps
+              << " steps, places " << (uninterrupted.places == resumed.places ? "identical" : "DIFFER") << "\n";
+    
+    // Shard Test
+    std::cout << "\n=== Shard Test ===\n";
+    
+    // 에퀴티 표본 묶음 64개를 샤드 4개로 나눠 각각 파일로 쓰고 합친 값 vs 한 번에 돌린 값
+    // (워커 프로세스로 띄우는 쪽은 poker_shard run)
+    EquityOptions shard_equity;
+    shard_equity.board_size = 5;
+    shard_equity.max_exhaustive = 0;
+    shard_equity.threads = 1;
+    const std::uint64_t shard_seed = 5;
+    std::vector<ShardResult> shard_results;
+    for (const auto& shard : split_shards(64, 4)) {
+        shard_equity.samples = shard.units * EQUITY_BATCH;
+        shard_equity.seed = shard_seed + shard.first * EQUITY_BATCH_STRIDE;
+        auto part = equity(Range::parse("AA"), Range::parse("KK"), shard_equity);
+        auto file = shard_file_name(shard);
+        write_shard_result(file, ShardResult{ShardJob::Equity, shard_job_key("AA vs KK"), shard, pack_equity(part)});
+        shard_results.push_back(read_shard_result(file));
+        std::remove(file.c_str());
+    }
+    auto sharded = unpack_equity(merge_shard_results(shard_results));
+    shard_equity.samples = 64 * EQUITY_BATCH;
+    shard_equity.seed = shard_seed;
+    auto single = equity(Range::parse("AA"), Range::parse("KK"), shard_equity);
+    std::cout << "AA vs KK: 4 shards " << sharded.equity() << " (" << sharded.samples << " samples), one run "
+              << single.equity() << " (" << single.samples << " samples)\n";
+    
+    // MCTS Test
+    std::cout << "\n=== MCTS Test ===\n";
+    
+    Player<5> mcts_player("Mcts", 1000);
+    Player<5> smart_player("Smart", 1000);
+    MctsOptions mcts_options;
+    mcts_options.budget = std::chrono::milliseconds(2);  // decide 마다 2ms 안에 답한다
+    MctsAI mcts_ai{mcts_options};
+    SmartAI mcts_rival;
+    Game mcts_game(10, nullptr);
+    mcts_game.add_player(&mcts_player, mcts_ai);
+    mcts_game.add_player(&smart_player, mcts_rival);
+    mcts_game.seed(11);
+    
+    for (int i = 0; i < 20 && mcts_player.chips() > 0 && smart_player.chips() > 0; ++i) {
+        mcts_game.start_round();
+    }
+    const auto& report = mcts_ai.last_report();
+    std::cout << "Mcts " << mcts_player.chips() << " vs Smart " << smart_player.chips()
+              << " (last decide: " << report.iterations << " iterations in "
+              << report.elapsed.count() << "us)\n";
+    
+    // Event Ring Test
+    std::cout << "\n=== Event Ring Test ===\n";
+    
+    // 테이블 스레드 4개가 작은 링에 동시에 넣고, 한 스레드가 묶음으로 비운다
+    MpscRing<HistoryEvent> event_ring(256);
+    std::vector<std::thread> producers;
+    for (std::uint32_t table = 0; table < 4; ++table) {
+        producers.emplace_back([&event_ring, table] {
+            for (std::uint32_t i = 0; i < 10'000; ++i) {
+                HistoryEvent event;
+                event.table_id = table;
+                event.amount = i;
+                event_ring.push(event);
+            }
+        });
+    }
+    std::array<std::uint32_t, 4> next_amount{};
+    size_t drained = 0, drains = 0, out_of_order = 0;
+    while (drained < 40'000) {
+        size_t n = event_ring.drain([&](const HistoryEvent& event) {
+            out_of_order += event.amount != next_amount[event.table_id]++;
+        });
+        drained += n;
+        drains += n > 0;
+        if (n == 0) std::this_thread::yield();
+    }
+    for (auto& producer : producers) producer.join();
+    std::cout << "Drained " << drained << " events in " << drains << " batches, "
+              << out_of_order << " out of order per table\n";
+    
+    // Trace Test
+    std::cout << "\n=== Trace Test ===\n";
+    
+    Tracer::enable();
+    matchup_options.max_blocks = 256;
+    Matchup<SmartAI, AggressiveAI>{{"Smart", "Aggressive"}, matchup_options}.run();
+    Tracer::disable();
+    
+    // chrome://tracing 또는 ui.perfetto.dev 에서 열기
+    size_t spans = Tracer::write_json("poker_trace.json");
+    std::cout << "poker_trace.json: " << spans << " spans\n";
+    
     // === GAME TEST ===
     std::cout << "\n========================================\n";
     std::cout << "=== POKER GAME: AI vs AI vs AI ===\n";
@@ -228,21 +551,49 @@ int main() {
     game.add_player(&bob, aggressive_ai);
     game.add_player(&charlie, smart_ai);
     
+    // 상대 통계 수집 → SmartAI 가 참고
+    StatsTracker tracker;
+    game.attach_stats(tracker);
+    smart_ai.watch(tracker.player("Alice"));
+    smart_ai.watch(tracker.player("Bob"));
+    
+    // 핸드 히스토리는 백그라운드 스레드가 hand_history.0001.txt 에 기록
+    HandHistoryExporter history;
+    game.attach_history(history, 1);
+    
     std::cout << "Players:\n";
     std::cout << "  Alice (Conservative): " << alice.chips() << " chips\n";
     std::cout << "  Bob (Aggressive):     " << bob.chips() << " chips\n";
     std::cout << "  Charlie (Smart):      " << charlie.chips() << " chips\n\n";
     
-    // 3 라운드 진행
-    for (int round = 1; round <= 3; ++round) {
+    // 3 라운드 진행. 칩이 떨어진 플레이어는 테이블에서 빼고, 한 명만 남으면 끝
+    std::vector<Player<5>*> seated{&alice, &bob, &charlie};
+    for (int round = 1; round <= 3 && seated.size() >= 2; ++round) {
         std::cout << "--- Round " << round << " ---\n";
         game.start_round();
         std::cout << "\nChips after round " << round << ":\n";
         std::cout << "  Alice:   " << alice.chips() << "\n";
         std::cout << "  Bob:     " << bob.chips() << "\n";
         std::cout << "  Charlie: " << charlie.chips() << "\n\n";
+        for (auto* p : std::vector<Player<5>*>(seated)) {
+            if (p->chips() > 0) continue;
+            std::cout << p->name() << " is out of chips\n\n";
+            game.remove_player(p);
+            std::erase(seated, p);
+        }
     }
     
+    std::cout << "Opponent stats:\n";
+    for (auto name : {"Alice", "Bob"}) {
+        auto profile = tracker.snapshot(name);
+        std::cout << "  " << name << ": VPIP " << profile.vpip_rate()
+                  << ", AF " << profile.aggression_frequency()
+                  << ", Fold to raise " << profile.fold_to_raise() << "\n";
+    }
+    
+    history.flush();
+    std::cout << "Hand history: " << history.bytes_written() << " bytes written\n\n";
+    
     std::cout << "========================================\n";
     std::cout << "=== GAME OVER ===\n";
     std::cout << "========================================\n";
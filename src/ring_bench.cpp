@@ -0,0 +1,148 @@
+#include <poker/event_ring.hpp>
+#include <poker/hand_history.hpp>
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+MpscRing 다중 생산자 스트레스 / 처리량 벤치마크
+
+    poker_ring_bench [--producers N] [--events E] [--capacity C] [--rounds R] [--mode push|try]
+
+생산자 N 개가 각자 E 개의 HistoryEvent (table_id = 생산자, amount = 0, 1, 2, ...) 를 넣고
+소비 스레드 하나가 drain 으로 비운다. 라운드마다
+- 처리량 (초당 이벤트), drain 묶음 수와 평균 크기, try 모드에서 가득 차서 다시 시도한 횟수
+- 생산자별 순서 (amount 가 하나씩 늘어나는지) 와 유실/중복 (끝에 생산자마다 정확히 E 개)
+를 확인한다. 순서가 틀리거나 빠진 이벤트가 있으면 종료 코드 1.
+*/
+
+namespace {
+
+struct BenchArgs {
+    unsigned producers{4};
+    std::uint32_t events{1'000'000};
+    size_t capacity{1 << 16};
+    unsigned rounds{3};
+    bool try_push{false};
+};
+
+struct RoundResult {
+    double seconds{0.0};
+    size_t drains{0};
+    std::uint64_t retries{0};
+    std::uint64_t out_of_order{0};
+    std::uint64_t missing{0};
+};
+
+RoundResult run_round(const BenchArgs& args) {
+    poker::MpscRing<poker::HistoryEvent> ring(args.capacity);
+    std::atomic<bool> go{false};
+    std::atomic<std::uint64_t> retries{0};
+
+    std::vector<std::thread> producers;
+    for (std::uint32_t p = 0; p < args.producers; ++p) {
+        producers.emplace_back([&, p] {
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            std::uint64_t spins = 0;
+            poker::HistoryEvent event;
+            event.table_id = p;
+            for (std::uint32_t i = 0; i < args.events; ++i) {
+                event.amount = i;
+                if (args.try_push) {
+                    while (!ring.try_push(event)) {
+                        ++spins;
+                        std::this_thread::yield();
+                    }
+                } else {
+                    ring.push(event);
+                }
+            }
+            retries.fetch_add(spins, std::memory_order_relaxed);
+        });
+    }
+
+    RoundResult result;
+    std::vector<std::uint32_t> next(args.producers, 0);
+    const std::uint64_t total = std::uint64_t{args.producers} * args.events;
+    std::uint64_t drained = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    while (drained < total) {
+        size_t n = ring.drain([&](const poker::HistoryEvent& event) {
+            if (event.table_id >= next.size() || event.amount != next[event.table_id]) {
+                ++result.out_of_order;
+                if (event.table_id < next.size()) next[event.table_id] = event.amount + 1;
+                return;
+            }
+            ++next[event.table_id];
+        });
+        drained += n;
+        result.drains += n > 0;
+        if (n == 0) std::this_thread::yield();
+    }
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (auto& producer : producers) producer.join();
+
+    // 다 받은 뒤에 더 남아 있으면 중복, 생산자별로 모자라면 유실
+    ring.drain([&](const poker::HistoryEvent&) { ++result.out_of_order; });
+    for (auto n : next) result.missing += args.events - std::min(n, args.events);
+    result.retries = retries.load(std::memory_order_relaxed);
+    return result;
+}
+
+BenchArgs parse(int argc, char** argv) {
+    BenchArgs args;
+    std::map<std::string, std::string> values;
+    for (int i = 1; i < argc; ++i) {
+        std::string key = argv[i];
+        if (key.rfind("--", 0) != 0 || i + 1 == argc) {
+            throw std::invalid_argument("usage: poker_ring_bench [--producers N] [--events E] [--capacity C] "
+                                        "[--rounds R] [--mode push|try]");
+        }
+        values[key.substr(2)] = argv[++i];
+    }
+    auto number = [&](const char* key, std::uint64_t fallback) {
+        auto it = values.find(key);
+        return it == values.end() ? fallback : std::stoull(it->second);
+    };
+    args.producers = static_cast<unsigned>(number("producers", args.producers));
+    args.events = static_cast<std::uint32_t>(number("events", args.events));
+    args.capacity = static_cast<size_t>(number("capacity", args.capacity));
+    args.rounds = static_cast<unsigned>(number("rounds", args.rounds));
+    if (values.contains("mode")) {
+        if (values["mode"] != "push" && values["mode"] != "try") throw std::invalid_argument("Unknown mode " + values["mode"]);
+        args.try_push = values["mode"] == "try";
+    }
+    if (args.producers == 0 || args.events == 0) throw std::invalid_argument("Need at least one producer and one event");
+    return args;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto args = parse(argc, argv);
+        const auto total = static_cast<double>(std::uint64_t{args.producers} * args.events);
+        std::cout << args.producers << " producers x " << args.events << " events, ring "
+                  << poker::MpscRing<poker::HistoryEvent>(args.capacity).capacity() << ", "
+                  << (args.try_push ? "try_push" : "push") << "\n";
+
+        bool ok = true;
+        for (unsigned r = 0; r < args.rounds; ++r) {
+            auto result = run_round(args);
+            std::cout << "round " << r + 1 << ": " << total / result.seconds / 1e6 << " M events/s, "
+                      << result.drains << " drains (" << total / static_cast<double>(std::max<size_t>(result.drains, 1))
+                      << " per drain), " << result.retries << " full retries, "
+                      << result.out_of_order << " out of order, " << result.missing << " missing\n";
+            ok = ok && result.out_of_order == 0 && result.missing == 0;
+        }
+        return ok ? 0 : 1;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+}
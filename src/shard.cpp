@@ -0,0 +1,175 @@
+#include <poker/shard.hpp>
+#include <poker/ai/aggressive.hpp>
+#include <poker/ai/smart.hpp>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+샤드 시뮬레이션 코디네이터 / 워커
+
+    poker_shard run   --job matchup --units 4000 --shards 8 --seed 7 --dir shards
+    poker_shard work  --job matchup --units 4000 --shards 8 --seed 7 --dir shards --shard 3
+    poker_shard merge --job matchup --units 4000 --shards 8 --seed 7 --dir shards
+
+run   = 샤드마다 자기 자신을 work 로 띄워 CPU 하나씩에 고정하고, 다 끝나면 merge
+work  = 샤드 하나만 계산해서 dir/shard-i-of-n.bin 을 쓴다 (다른 머신에서 공유 디렉터리로 돌려도 된다)
+merge = dir 의 샤드 파일을 샤드 번호 순서로 합쳐서 출력
+
+job matchup: Smart vs Aggressive 미러 딜 블록 (units = 블록 수)
+job equity:  --hero / --villain 레인지 홀덤 에퀴티 몬테카를로 (units = 4096 표본 묶음 수)
+모든 모드가 같은 인자에서 같은 샤드 경계와 같은 작업 지문을 만든다.
+*/
+
+namespace {
+
+struct ShardArgs {
+    std::string mode;
+    std::string job{"matchup"};
+    std::uint64_t units{0};
+    std::uint32_t shards{0};
+    std::uint32_t shard{0};
+    std::uint32_t seed{1};
+    std::string hero{"AA"};
+    std::string villain{"KK"};
+    std::filesystem::path dir{"shards"};
+    bool pin{true};
+};
+
+using SmartVsAggressive = poker::Matchup<poker::SmartAI, poker::AggressiveAI>;
+
+SmartVsAggressive make_matchup(const ShardArgs& args) {
+    poker::MatchupOptions options;
+    options.threads = 1;    // 워커 하나 = 코어 하나
+    options.seed = args.seed;
+    return SmartVsAggressive{{"Smart", "Aggressive"}, options};
+}
+
+poker::ShardJob job_of(const ShardArgs& args) {
+    return args.job == "equity" ? poker::ShardJob::Equity : poker::ShardJob::Matchup;
+}
+
+// 결과에 영향을 주는 인자만 (dir, pin 은 빼고)
+std::uint64_t job_key(const ShardArgs& args) {
+    std::string description = args.job + " units=" + std::to_string(args.units) + " shards=" +
+                              std::to_string(args.shards) + " seed=" + std::to_string(args.seed);
+    if (job_of(args) == poker::ShardJob::Equity) description += " hero=" + args.hero + " villain=" + args.villain;
+    return poker::shard_job_key(description);
+}
+
+void work(const ShardArgs& args) {
+    const auto shard = poker::split_shards(args.units, args.shards).at(args.shard);
+    poker::ShardResult result{job_of(args), job_key(args), shard, {}};
+
+    if (result.job == poker::ShardJob::Matchup) {
+        result.values = poker::pack_stats(make_matchup(args).play_blocks(args.seed, shard.first, shard.units));
+    } else {
+        // 큰 실행의 묶음 [first, first + units) 와 같은 난수를 쓰도록 시드를 민다
+        poker::EquityOptions options;
+        options.board_size = 5;
+        options.max_exhaustive = 0;
+        options.samples = shard.units * poker::EQUITY_BATCH;
+        options.threads = 1;
+        options.seed = args.seed + shard.first * poker::EQUITY_BATCH_STRIDE;
+        if (shard.units) {
+            result.values = poker::pack_equity(
+                poker::equity(poker::Range::parse(args.hero), poker::Range::parse(args.villain), options));
+        } else {
+            result.values.assign(4, 0.0);
+        }
+    }
+    std::filesystem::create_directories(args.dir);
+    poker::write_shard_result(args.dir / poker::shard_file_name(shard), result);
+}
+
+int merge(const ShardArgs& args) {
+    const auto merged = poker::merge_shard_directory(args.dir, args.shards);
+    if (job_of(args) == poker::ShardJob::Matchup) {
+        auto result = make_matchup(args).summarize(poker::unpack_stats<SmartVsAggressive::SEATS>(merged));
+        for (auto& r : result.strategies) {
+            std::cout << r.name << ": " << r.bb_per_100 << " bb/100 (+/- " << r.ci95 << ")\n";
+        }
+        const char* verdict = result.verdict == poker::SprtVerdict::Better ? "Better"
+                            : result.verdict == poker::SprtVerdict::Worse ? "Worse" : "Inconclusive";
+        std::cout << result.blocks << " blocks, " << result.hands << " hands, LLR " << result.llr
+                  << " -> " << verdict << "\n";
+    } else {
+        auto result = poker::unpack_equity(merged);
+        std::cout << args.hero << " vs " << args.villain << ": equity " << result.equity() << " (win " << result.win
+                  << ", tie " << result.tie << ", " << result.samples << " samples)\n";
+    }
+    return 0;
+}
+
+int run(const ShardArgs& args, const char* self) {
+    // 이 실행 파일을 work 모드로 샤드 수만큼
+    std::string exe = self;
+#if defined(__linux__)
+    std::error_code error;
+    auto resolved = std::filesystem::read_symlink("/proc/self/exe", error);
+    if (!error) exe = resolved.string();
+#endif
+    std::filesystem::create_directories(args.dir);
+    std::vector<std::vector<std::string>> commands;
+    for (std::uint32_t i = 0; i < args.shards; ++i) {
+        commands.push_back({exe, "work", "--job", args.job, "--units", std::to_string(args.units),
+                            "--shards", std::to_string(args.shards), "--shard", std::to_string(i),
+                            "--seed", std::to_string(args.seed), "--dir", args.dir.string(),
+                            "--hero", args.hero, "--villain", args.villain});
+    }
+    auto failed = poker::run_worker_processes(commands, args.pin);
+    if (!failed.empty()) {
+        std::cerr << failed.size() << " of " << args.shards << " workers failed (first: shard " << failed.front() << ")\n";
+        return 1;
+    }
+    return merge(args);
+}
+
+ShardArgs parse(int argc, char** argv) {
+    if (argc < 2) throw std::invalid_argument("usage: poker_shard run|work|merge [--job matchup|equity] [--units N] "
+                                              "[--shards K] [--shard I] [--seed S] [--dir D] [--hero R] [--villain R] [--no-pin]");
+    ShardArgs args;
+    args.mode = argv[1];
+    std::map<std::string, std::string> values;
+    for (int i = 2; i < argc; ++i) {
+        std::string key = argv[i];
+        if (key == "--no-pin") { args.pin = false; continue; }
+        if (key.rfind("--", 0) != 0 || i + 1 == argc) throw std::invalid_argument("Bad argument " + key);
+        values[key.substr(2)] = argv[++i];
+    }
+    auto number = [&](const char* key, std::uint64_t fallback) {
+        auto it = values.find(key);
+        return it == values.end() ? fallback : std::stoull(it->second);
+    };
+    if (values.contains("job")) args.job = values["job"];
+    if (args.job != "matchup" && args.job != "equity") throw std::invalid_argument("Unknown job " + args.job);
+    args.units = number("units", args.job == "matchup" ? 4000 : 256);
+    args.shards = static_cast<std::uint32_t>(number("shards", poker::default_thread_count()));
+    args.shard = static_cast<std::uint32_t>(number("shard", 0));
+    args.seed = static_cast<std::uint32_t>(number("seed", 1));
+    if (values.contains("dir")) args.dir = values["dir"];
+    if (values.contains("hero")) args.hero = values["hero"];
+    if (values.contains("villain")) args.villain = values["villain"];
+    if (args.shards == 0 || args.shard >= args.shards) throw std::invalid_argument("Shard index out of range");
+    return args;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        auto args = parse(argc, argv);
+        if (args.mode == "work") {
+            work(args);
+            return 0;
+        }
+        if (args.mode == "merge") return merge(args);
+        if (args.mode == "run") return run(args, argv[0]);
+        throw std::invalid_argument("Unknown mode " + args.mode);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 2;
+    }
+}